@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include <asiochan/asiochan.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <asio/io_context.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#endif
+
+// Compares the latency of operations through type-erased channel handles with the same operations
+// on the concrete channel type: non-waiting try_write / try_read pairs on a buffered channel,
+// and awaited write / read exchanges between two coroutines on an unbuffered channel.
+
+namespace asio = asiochan::asio;
+
+static constexpr auto num_try_ops = std::size_t{10'000'000};
+static constexpr auto num_exchanges = std::size_t{1'000'000};
+
+template <typename Writer, typename Reader>
+auto measure_try_ops(Writer writer, Reader reader) -> double
+{
+    auto checksum = std::uint64_t{0};
+    auto const start = std::chrono::steady_clock::now();
+
+    for (auto i = std::size_t{0}; i < num_try_ops; ++i)
+    {
+        if (writer.try_write(i))
+        {
+            checksum += *reader.try_read();
+        }
+    }
+
+    auto const duration = std::chrono::duration<double, std::nano>{std::chrono::steady_clock::now() - start};
+    if (checksum == 0)
+    {
+        std::cout << "Unexpected checksum\n";
+    }
+
+    return duration.count() / static_cast<double>(2 * num_try_ops);
+}
+
+template <typename Writer, typename Reader>
+auto measure_exchanges(asio::io_context& io_context, Writer writer, Reader reader) -> double
+{
+    auto checksum = std::uint64_t{0};
+    auto const start = std::chrono::steady_clock::now();
+
+    asio::co_spawn(
+        io_context,
+        [writer]() mutable -> asio::awaitable<void>
+        {
+            for (auto i = std::size_t{0}; i < num_exchanges; ++i)
+            {
+                co_await writer.write(i);
+            }
+        },
+        asio::detached);
+    asio::co_spawn(
+        io_context,
+        [reader, &checksum]() mutable -> asio::awaitable<void>
+        {
+            for (auto i = std::size_t{0}; i < num_exchanges; ++i)
+            {
+                checksum += co_await reader.read();
+            }
+        },
+        asio::detached);
+    io_context.run();
+    io_context.restart();
+
+    auto const duration = std::chrono::duration<double, std::nano>{std::chrono::steady_clock::now() - start};
+    if (checksum == 0)
+    {
+        std::cout << "Unexpected checksum\n";
+    }
+
+    return duration.count() / static_cast<double>(2 * num_exchanges);
+}
+
+auto main() -> int
+{
+    auto io_context = asio::io_context{1};
+
+    {
+        auto channel = asiochan::channel<std::size_t, 1>{};
+        auto const concrete = measure_try_ops(channel, channel);
+        auto const erased = measure_try_ops(
+            asiochan::any_write_channel<std::size_t>{channel},
+            asiochan::any_read_channel<std::size_t>{channel});
+        std::cout << "try_write / try_read: concrete " << concrete << " ns/op"
+                  << ", erased " << erased << " ns/op\n";
+    }
+
+    {
+        auto channel = asiochan::channel<std::size_t>{};
+        auto const concrete = measure_exchanges(io_context, channel, channel);
+        auto const erased = measure_exchanges(
+            io_context,
+            asiochan::any_write_channel<std::size_t>{channel},
+            asiochan::any_read_channel<std::size_t>{channel});
+        std::cout << "write / read: concrete " << concrete << " ns/op"
+                  << ", erased " << erased << " ns/op\n";
+    }
+
+    return EXIT_SUCCESS;
+}
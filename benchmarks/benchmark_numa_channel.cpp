@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <asiochan/asiochan.hpp>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Measures the throughput of a bounded channel between two pinned threads,
+// with the channel shared state placed on the node of the writer, the reader or neither.
+
+using numa_channel = asiochan::basic_channel<
+    std::size_t,
+    64,
+    asiochan::asio::any_io_executor,
+    asiochan::numa_channel_policy>;
+
+static constexpr auto num_messages = std::size_t{2'000'000};
+
+auto node_cpus(int node) -> std::vector<int>
+{
+    auto cpus = std::vector<int>{};
+
+    // The cpulist has the form "0-3,8-11".
+    auto file = std::ifstream{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+    auto range = std::string{};
+    while (std::getline(file, range, ','))
+    {
+        auto first = 0;
+        auto last = 0;
+        auto separator = '\0';
+        auto stream = std::istringstream{range};
+        if (not(stream >> first))
+        {
+            continue;
+        }
+        last = (stream >> separator >> last) ? last : first;
+
+        for (auto cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+void pin_to_node(std::thread& thread, int node)
+{
+#if defined(__linux__)
+    auto const cpus = node_cpus(node);
+    if (cpus.empty())
+    {
+        return;
+    }
+
+    auto set = cpu_set_t{};
+    CPU_ZERO(&set);
+    for (auto cpu : cpus)
+    {
+        CPU_SET(cpu, &set);
+    }
+
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#endif
+}
+
+auto measure(int writer_node, int reader_node, int channel_node) -> double
+{
+    auto channel = numa_channel{std::allocator_arg, asiochan::numa_allocator<std::byte>{channel_node}};
+
+    auto const start = std::chrono::steady_clock::now();
+
+    auto writer = std::thread{
+        [channel]() mutable
+        {
+            for (auto i = std::size_t{0}; i < num_messages; ++i)
+            {
+                while (not channel.try_write(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }};
+    pin_to_node(writer, writer_node);
+
+    auto reader = std::thread{
+        [channel]() mutable
+        {
+            for (auto i = std::size_t{0}; i < num_messages; ++i)
+            {
+                while (not channel.try_read())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }};
+    pin_to_node(reader, reader_node);
+
+    writer.join();
+    reader.join();
+
+    auto const duration = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+    return static_cast<double>(num_messages) / duration.count();
+}
+
+void report(char const* name, int writer_node, int reader_node, int channel_node)
+{
+    auto const throughput = measure(writer_node, reader_node, channel_node);
+    std::cout << name
+              << " (writer on " << writer_node
+              << ", reader on " << reader_node
+              << ", channel on " << channel_node << "): "
+              << throughput / 1e6 << " Mmsg/s\n";
+}
+
+auto main() -> int
+{
+    auto const num_nodes = asiochan::numa_node_count();
+    std::cout << "NUMA nodes: " << num_nodes << "\n";
+
+    report("Local", 0, 0, 0);
+
+    if (num_nodes < 2)
+    {
+        std::cout << "Single node machine, skipping the cross-socket measurements.\n";
+        return EXIT_SUCCESS;
+    }
+
+    report("Remote channel", 0, 0, 1);
+    report("Cross-socket, channel on writer node", 0, 1, 0);
+    report("Cross-socket, channel on reader node", 0, 1, 1);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <thread>
+
+#include <asiochan/asiochan.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+
+#else
+
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+
+#endif
+
+// Measures the throughput of transform and ordered_parallel_map stages on a thread pool,
+// for an increasing number of workers, with a CPU bound function of a few microseconds.
+
+namespace asio = asiochan::asio;
+
+using stream = asiochan::unbounded_channel<std::optional<std::uint64_t>>;
+
+static constexpr auto num_messages = std::size_t{20'000};
+static constexpr auto num_rounds = 2'000;
+
+auto work(std::uint64_t value) -> std::uint64_t
+{
+    // xorshift rounds, which the compiler cannot fold.
+    for (auto i = 0; i < num_rounds; ++i)
+    {
+        value ^= value << 13;
+        value ^= value >> 7;
+        value ^= value << 17;
+    }
+
+    return value;
+}
+
+auto measure(std::size_t parallelism, bool ordered) -> double
+{
+    auto thread_pool = asio::thread_pool{std::max(1u, std::thread::hardware_concurrency())};
+    auto input = stream{};
+    auto output = stream{};
+
+    for (auto i = std::size_t{0}; i < num_messages; ++i)
+    {
+        input.write(i + 1);
+    }
+    input.write(std::nullopt);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    auto stage = asio::co_spawn(
+        thread_pool,
+        ordered ? asiochan::ordered_parallel_map(input, output, work, parallelism)
+                : asiochan::transform(input, output, work, parallelism),
+        asio::use_future);
+
+    auto checksum = std::uint64_t{0};
+    while (auto const value = output.blocking_read())
+    {
+        checksum ^= *value;
+    }
+    stage.get();
+
+    auto const duration = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+    if (checksum == 0)
+    {
+        std::cout << "Unexpected checksum\n";
+    }
+
+    return static_cast<double>(num_messages) / duration.count();
+}
+
+auto main() -> int
+{
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+
+    for (auto const parallelism : {1u, 2u, 4u, 8u, 16u})
+    {
+        auto const unordered = measure(parallelism, false);
+        auto const ordered = measure(parallelism, true);
+        std::cout << "Parallelism " << parallelism
+                  << ": transform " << unordered / 1e3 << " kmsg/s"
+                  << ", ordered_parallel_map " << ordered / 1e3 << " kmsg/s\n";
+    }
+
+    return EXIT_SUCCESS;
+}
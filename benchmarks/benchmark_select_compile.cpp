@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <asiochan/channel.hpp>
+#include <asiochan/nothing_op.hpp>
+#include <asiochan/select.hpp>
+
+// Instantiates select, select_ready and the select_result accessors for ASIOCHAN_BENCHMARK_SELECT_OPS operations.
+// Each operation reads a distinct message type, so that no instantiation is shared between them.
+
+#ifndef ASIOCHAN_BENCHMARK_SELECT_OPS
+#define ASIOCHAN_BENCHMARK_SELECT_OPS 4
+#endif
+
+namespace
+{
+    template <std::size_t index>
+    struct message
+    {
+        int value = 0;
+    };
+
+    template <std::size_t... indices>
+    using channels_type = std::tuple<asiochan::channel<message<indices>, 1>...>;
+
+    template <std::size_t... indices>
+    auto sum_received(auto const& result) -> int
+    {
+        auto sum = 0;
+        ((sum += result.template received<message<indices>>()
+                     ? result.template get_received<message<indices>>().value
+                     : 0),
+         ...);
+
+        return sum;
+    }
+
+    template <std::size_t... indices>
+    auto select_all(channels_type<indices...>& channels, std::index_sequence<indices...>)
+        -> asiochan::asio::awaitable<int>
+    {
+        auto const ready = asiochan::select_ready(
+            asiochan::ops::read(std::get<indices>(channels))...,
+            asiochan::ops::nothing);
+        if (ready.has_value())
+        {
+            co_return sum_received<indices...>(ready);
+        }
+
+        auto const result = co_await asiochan::select(asiochan::ops::read(std::get<indices>(channels))...);
+
+        co_return sum_received<indices...>(result);
+    }
+
+    using benchmark_sequence = std::make_index_sequence<ASIOCHAN_BENCHMARK_SELECT_OPS>;
+}  // namespace
+
+auto benchmark_select_compile() -> asiochan::asio::awaitable<int>
+{
+    auto channels = []<std::size_t... indices>(std::index_sequence<indices...>)
+    {
+        return channels_type<indices...>{};
+    }(benchmark_sequence{});
+
+    co_return co_await select_all(channels, benchmark_sequence{});
+}
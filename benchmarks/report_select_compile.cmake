@@ -0,0 +1,20 @@
+# Prints the compile time and object size recorded for each select benchmark object.
+# Usage: cmake -DOBJECTS=<num_ops>=<object>;... -P report_select_compile.cmake
+
+message("ops  compile time  object size")
+foreach(entry IN LISTS OBJECTS)
+  string(REGEX MATCH "^([0-9]+)=(.*)$" _ "${entry}")
+  set(num_ops "${CMAKE_MATCH_1}")
+  set(object "${CMAKE_MATCH_2}")
+
+  set(elapsed_ms "?")
+  if(EXISTS "${object}.time")
+    file(READ "${object}.time" elapsed_ms)
+  endif()
+  file(SIZE "${object}" object_size)
+
+  string(LENGTH "${num_ops}" num_ops_length)
+  math(EXPR padding "3 - ${num_ops_length}")
+  string(REPEAT " " ${padding} indent)
+  message("${indent}${num_ops}  ${elapsed_ms} ms  ${object_size} bytes")
+endforeach()
@@ -0,0 +1,35 @@
+# Compiler launcher recording the wall time of a compilation next to its object file.
+# Usage: cmake -P time_compile.cmake -- <compiler> <args...>
+
+set(command)
+set(object)
+set(in_command FALSE)
+set(next_is_object FALSE)
+math(EXPR last_arg "${CMAKE_ARGC} - 1")
+foreach(index RANGE ${last_arg})
+  set(arg "${CMAKE_ARGV${index}}")
+  if(in_command)
+    list(APPEND command "${arg}")
+    if(next_is_object)
+      set(object "${arg}")
+      set(next_is_object FALSE)
+    elseif(arg STREQUAL "-o")
+      set(next_is_object TRUE)
+    endif()
+  elseif(arg STREQUAL "--")
+    set(in_command TRUE)
+  endif()
+endforeach()
+
+string(TIMESTAMP start "%s%f")
+execute_process(COMMAND ${command} RESULT_VARIABLE result)
+string(TIMESTAMP stop "%s%f")
+
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Compilation failed: ${result}")
+endif()
+
+if(object)
+  math(EXPR elapsed_ms "(${stop} - ${start}) / 1000")
+  file(WRITE "${object}.time" "${elapsed_ms}")
+endif()
@@ -41,9 +41,9 @@ class AsioChan(ConanFile):
 
     def requirements(self):
         if self.options.asio == "boost":
-            self.requires("boost/1.75.0")
+            self.requires("boost/1.77.0")
         else:
-            self.requires("asio/1.18.1")
+            self.requires("asio/1.19.2")
 
     def build(self):
         cmake = CMake(self)
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "asiochan/detail/cpu_relax.hpp"
+
+namespace asiochan
+{
+    class adaptive_spin
+    {
+      public:
+        using clock = std::chrono::steady_clock;
+
+        // Times a wait that parked after spinning in vain, see spin.
+        class parked_wait
+        {
+          public:
+            // Reports that the parked waiter was woken. Does nothing unless a spin failed.
+            void woken() noexcept
+            {
+                if (auto const spin = std::exchange(spin_, nullptr))
+                {
+                    spin->record_parked(spent_, spin_time_, clock::now() - parked_at_);
+                }
+            }
+
+          private:
+            friend adaptive_spin;
+
+            adaptive_spin* spin_ = nullptr;
+            std::uint32_t spent_ = 0;
+            clock::duration spin_time_ = {};
+            clock::time_point parked_at_ = {};
+        };
+
+        static constexpr auto default_initial_budget = std::uint32_t{256};
+        static constexpr auto default_max_budget = std::uint32_t{16384};
+        static constexpr auto min_budget = std::uint32_t{16};
+
+        explicit adaptive_spin(
+            std::uint32_t const initial_budget = default_initial_budget,
+            std::uint32_t const max_budget = default_max_budget) noexcept
+          : budget_{std::clamp(initial_budget, min_budget, std::max(min_budget, max_budget))}
+          , max_budget_{std::max(min_budget, max_budget)}
+        {
+        }
+
+        adaptive_spin(adaptive_spin const&) = delete;
+        auto operator=(adaptive_spin const&) -> adaptive_spin& = delete;
+
+        // Current number of pause instructions a waiter may spend before parking.
+        [[nodiscard]] auto budget() const noexcept -> std::uint32_t
+        {
+            return budget_.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] auto max_budget() const noexcept -> std::uint32_t
+        {
+            return max_budget_;
+        }
+
+        // Polls until the result is truthy or the budget is spent.
+        // When spinning fails, the caller parks and reports its wakeup to the wait,
+        // so that the budget is tuned from how long the spin fell short.
+        // clang-format off
+        template <std::invocable Poll>
+        requires std::constructible_from<bool, std::invoke_result_t<Poll&>>
+        [[nodiscard]] auto spin(Poll&& poll, parked_wait& wait) -> std::invoke_result_t<Poll&>
+        // clang-format on
+        {
+            auto const budget = this->budget();
+            auto const started_at = clock::now();
+            auto spent = std::uint32_t{0};
+            auto backoff = std::uint32_t{1};
+
+            while (true)
+            {
+                if (auto result = poll())
+                {
+                    // Immediate successes say nothing about the handoff latency.
+                    if (spent != 0)
+                    {
+                        record_success(spent);
+                    }
+                    return result;
+                }
+
+                if (spent >= budget)
+                {
+                    wait.spin_ = this;
+                    wait.spent_ = spent;
+                    wait.parked_at_ = clock::now();
+                    wait.spin_time_ = wait.parked_at_ - started_at;
+                    return {};
+                }
+
+                // Poll with exponential backoff, so that spinning waiters do not
+                // hammer the channel mutex the peer needs to make progress.
+                for (auto i = std::uint32_t{0}; i < backoff; ++i)
+                {
+                    detail::cpu_relax();
+                }
+                spent += backoff;
+                backoff = std::min(backoff * 2, max_backoff);
+            }
+        }
+
+      private:
+        static constexpr auto max_backoff = std::uint32_t{64};
+
+        std::atomic<std::uint32_t> budget_;
+        std::uint32_t max_budget_;
+
+        void record_success(std::uint32_t const spent) noexcept
+        {
+            // Track twice the observed handoff latency, so that a typical handoff
+            // completes well within the budget.
+            auto const target = std::clamp(spent * 2, min_budget, max_budget_);
+            auto const budget = this->budget();
+            budget_.store((budget * 3 + target) / 4, std::memory_order_relaxed);
+        }
+
+        void record_parked(
+            std::uint32_t const spent,
+            clock::duration const spin_time,
+            clock::duration const parked_time) noexcept
+        {
+            // Estimate how many pauses the waiter would have needed, at the pace of the failed spin.
+            auto const pause_time = std::chrono::duration<double>{std::max(spin_time, clock::duration{1})} / spent;
+            auto const latency = spent + std::chrono::duration<double>{parked_time} / pause_time;
+
+            if (latency <= max_budget_)
+            {
+                // The peer arrived soon after parking, so a larger budget would have caught it.
+                record_success(static_cast<std::uint32_t>(latency));
+            }
+            else
+            {
+                // The peer was out of reach of any budget, back off quickly towards parking immediately.
+                auto const budget = this->budget();
+                budget_.store(std::max(min_budget, budget / 2), std::memory_order_relaxed);
+            }
+        }
+    };
+}  // namespace asiochan
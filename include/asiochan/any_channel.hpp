@@ -0,0 +1,408 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/channel_concepts.hpp"
+#include "asiochan/channel_stats.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/send_slot.hpp"
+#include "asiochan/read_op.hpp"
+#include "asiochan/select.hpp"
+#include "asiochan/sendable.hpp"
+#include "asiochan/write_op.hpp"
+
+namespace asiochan
+{
+    namespace detail
+    {
+        // One direction of a channel, with its shared state erased.
+        // Every entry performs a whole sub-operation of select, so erased operations
+        // pay a single indirect call per step, rather than one per access to the channel state.
+        template <sendable_value T, asio::execution::executor Executor>
+        struct any_channel_vtable
+        {
+            using slot_type = send_slot<T>;
+            // The erased channel may be registered or traced, so its waiters always carry the park stamp.
+            using waiter_node_type = channel_stamped_waiter_list_node<T, Executor>;
+            using wait_stamp_type = channel_wait_stamp<true>;
+
+            // Whether the channel records statistics, and so needs the wait stamp of parked operations.
+            bool stats_enabled;
+
+            bool (*submit_if_ready)(void* shared_state, slot_type& slot);
+
+            channel_submit_result (*submit_with_wait)(
+                void* shared_state,
+                select_wait_context<Executor>& select_ctx,
+                select_waiter_token token,
+                slot_type& slot,
+                std::optional<waiter_node_type>& waiter_node);
+
+            void (*clear_wait)(
+                void* shared_state,
+                std::optional<waiter_node_type>& waiter_node,
+                bool successful,
+                wait_stamp_type const& wait_stamp);
+        };
+
+        template <typename ChannelState, sendable_value T, asio::execution::executor Executor>
+        inline constexpr auto any_read_channel_vtable = any_channel_vtable<T, Executor>{
+            .stats_enabled = ChannelState::stats_enabled,
+            .submit_if_ready = [](void* const shared_state, send_slot<T>& slot)
+            {
+                return read_if_ready(*static_cast<ChannelState*>(shared_state), slot);
+            },
+            .submit_with_wait = [](void* const shared_state,
+                                   select_wait_context<Executor>& select_ctx,
+                                   select_waiter_token const token,
+                                   send_slot<T>& slot,
+                                   std::optional<channel_stamped_waiter_list_node<T, Executor>>& waiter_node)
+            {
+                return read_or_wait(*static_cast<ChannelState*>(shared_state), select_ctx, token, slot, waiter_node);
+            },
+            .clear_wait = [](void* const shared_state,
+                             std::optional<channel_stamped_waiter_list_node<T, Executor>>& waiter_node,
+                             bool const successful,
+                             channel_wait_stamp<true> const& wait_stamp)
+            {
+                if constexpr (ChannelState::stats_enabled)
+                {
+                    clear_read_wait(*static_cast<ChannelState*>(shared_state), waiter_node, successful, wait_stamp);
+                }
+                else
+                {
+                    clear_read_wait(
+                        *static_cast<ChannelState*>(shared_state),
+                        waiter_node,
+                        successful,
+                        channel_wait_stamp<false>{});
+                }
+            },
+        };
+
+        template <typename ChannelState, sendable_value T, asio::execution::executor Executor>
+        inline constexpr auto any_write_channel_vtable = any_channel_vtable<T, Executor>{
+            .stats_enabled = ChannelState::stats_enabled,
+            .submit_if_ready = [](void* const shared_state, send_slot<T>& slot)
+            {
+                return write_if_ready(*static_cast<ChannelState*>(shared_state), slot);
+            },
+            .submit_with_wait = [](void* const shared_state,
+                                   select_wait_context<Executor>& select_ctx,
+                                   select_waiter_token const token,
+                                   send_slot<T>& slot,
+                                   std::optional<channel_stamped_waiter_list_node<T, Executor>>& waiter_node)
+            {
+                return write_or_wait(*static_cast<ChannelState*>(shared_state), select_ctx, token, slot, waiter_node);
+            },
+            .clear_wait = [](void* const shared_state,
+                             std::optional<channel_stamped_waiter_list_node<T, Executor>>& waiter_node,
+                             bool const successful,
+                             channel_wait_stamp<true> const& wait_stamp)
+            {
+                if constexpr (ChannelState::stats_enabled)
+                {
+                    clear_write_wait(*static_cast<ChannelState*>(shared_state), waiter_node, successful, wait_stamp);
+                }
+                else
+                {
+                    clear_write_wait(
+                        *static_cast<ChannelState*>(shared_state),
+                        waiter_node,
+                        successful,
+                        channel_wait_stamp<false>{});
+                }
+            },
+        };
+
+        // The erased channel alternatives of a read or write operation.
+        template <sendable_value T, asio::execution::executor Executor, std::size_t num_alternatives_>
+        class any_channel_op_base
+        {
+          public:
+            using executor_type = Executor;
+            using slot_type = send_slot<T>;
+            using vtable_type = any_channel_vtable<T, Executor>;
+
+            static constexpr auto num_alternatives = num_alternatives_;
+            static constexpr auto always_waitfree = false;
+
+            struct wait_state_type
+            {
+                std::array<std::optional<typename vtable_type::waiter_node_type>, num_alternatives> waiter_nodes = {};
+                typename vtable_type::wait_stamp_type wait_stamp = {};
+            };
+
+            [[nodiscard]] auto submit_if_ready() -> std::optional<std::size_t>
+            {
+                for (auto i = std::size_t{0}; i < num_alternatives; ++i)
+                {
+                    if (vtables_[i]->submit_if_ready(shared_states_[i], slot_))
+                    {
+                        return i;
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            [[nodiscard]] auto submit_with_wait(
+                select_wait_context<executor_type>& select_ctx,
+                select_waiter_token const base_token,
+                wait_state_type& wait_state)
+                -> std::optional<std::size_t>
+            {
+                for (auto i = std::size_t{0}; i < num_alternatives; ++i)
+                {
+                    switch (vtables_[i]->submit_with_wait(
+                        shared_states_[i],
+                        select_ctx,
+                        base_token + i,
+                        slot_,
+                        wait_state.waiter_nodes[i]))
+                    {
+                    case channel_submit_result::ready:
+                        return i;
+                    case channel_submit_result::waiting:
+                        if (vtables_[i]->stats_enabled)
+                        {
+                            wait_state.wait_stamp.start();
+                        }
+                        break;
+                    case channel_submit_result::claimed_elsewhere:
+                        return std::nullopt;
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            void clear_wait(
+                std::optional<std::size_t> const successful_alternative,
+                wait_state_type& wait_state)
+            {
+                for (auto i = std::size_t{0}; i < num_alternatives; ++i)
+                {
+                    vtables_[i]->clear_wait(
+                        shared_states_[i],
+                        wait_state.waiter_nodes[i],
+                        i == successful_alternative,
+                        wait_state.wait_stamp);
+                }
+            }
+
+          protected:
+            template <typename... Channels>
+            explicit any_channel_op_base(Channels const&... channels) noexcept
+              : shared_states_{channels.shared_state_.get()...}
+              , vtables_{channels.vtable_...}
+            {
+            }
+
+            std::array<void*, num_alternatives> shared_states_;
+            std::array<vtable_type const*, num_alternatives> vtables_;
+            slot_type slot_;
+        };
+    }  // namespace detail
+
+    template <sendable_value T, asio::execution::executor Executor>
+    class basic_any_read_channel;
+
+    template <sendable_value T, asio::execution::executor Executor>
+    class basic_any_write_channel;
+
+    namespace ops
+    {
+        template <sendable_value T, asio::execution::executor Executor, std::size_t num_alternatives = 1>
+        class any_read : public detail::any_channel_op_base<T, Executor, num_alternatives>
+        {
+          private:
+            using base = detail::any_channel_op_base<T, Executor, num_alternatives>;
+
+          public:
+            using result_type = read_result<T>;
+
+            // clang-format off
+            template <std::same_as<basic_any_read_channel<T, Executor>>... ChannelsTail>
+            requires (sizeof...(ChannelsTail) + 1 == num_alternatives)
+            explicit any_read(
+                basic_any_read_channel<T, Executor> const& channels_head,
+                ChannelsTail const&... channels_tail) noexcept
+              // clang-format on
+              : base{channels_head, channels_tail...}
+            {
+            }
+
+            [[nodiscard]] auto get_result(std::size_t const successful_alternative) noexcept -> result_type
+            {
+                return result_type{this->slot_.read(), this->shared_states_[successful_alternative]};
+            }
+        };
+
+        template <sendable_value T, asio::execution::executor Executor, std::size_t num_alternatives = 1>
+        class any_write : public detail::any_channel_op_base<T, Executor, num_alternatives>
+        {
+          private:
+            using base = detail::any_channel_op_base<T, Executor, num_alternatives>;
+
+          public:
+            using result_type = write_result<T>;
+
+            // clang-format off
+            template <std::convertible_to<T> U,
+                      std::same_as<basic_any_write_channel<T, Executor>>... ChannelsTail>
+            requires (sizeof...(ChannelsTail) + 1 == num_alternatives)
+            any_write(
+                U&& value,
+                basic_any_write_channel<T, Executor> const& channels_head,
+                ChannelsTail const&... channels_tail) noexcept
+              // clang-format on
+              : base{channels_head, channels_tail...}
+            {
+                this->slot_.write(T{std::forward<U>(value)});
+            }
+
+            [[nodiscard]] auto get_result(std::size_t const successful_alternative) noexcept -> result_type
+            {
+                return result_type{this->shared_states_[successful_alternative]};
+            }
+        };
+
+        template <sendable_value T, asio::execution::executor Executor, typename... ChannelsTail>
+        any_read(basic_any_read_channel<T, Executor> const&, ChannelsTail const&...)
+            -> any_read<T, Executor, sizeof...(ChannelsTail) + 1>;
+
+        template <typename U, sendable_value T, asio::execution::executor Executor, typename... ChannelsTail>
+        any_write(U&&, basic_any_write_channel<T, Executor> const&, ChannelsTail const&...)
+            -> any_write<T, Executor, sizeof...(ChannelsTail) + 1>;
+    }  // namespace ops
+
+    // A read handle to any readable channel of T, regardless of its buffer size and policy.
+    template <sendable_value T, asio::execution::executor Executor>
+    class basic_any_read_channel
+    {
+      public:
+        using executor_type = Executor;
+        using send_type = T;
+
+        // clang-format off
+        template <any_readable_channel_type Channel>
+        requires std::same_as<typename Channel::send_type, T>
+                 and std::same_as<typename Channel::executor_type, Executor>
+        [[nodiscard]] basic_any_read_channel(Channel const& channel)
+          // clang-format on
+          : shared_state_{channel.shared_state_ptr()}
+          , vtable_{&detail::any_read_channel_vtable<typename Channel::shared_state_type, T, Executor>}
+        {
+        }
+
+        // A read operation, for use in select.
+        [[nodiscard]] auto read_op() const noexcept -> ops::any_read<T, Executor>
+        {
+            return ops::any_read<T, Executor>{*this};
+        }
+
+        [[nodiscard]] auto try_read() -> std::optional<T>
+        {
+            auto slot = detail::send_slot<T>{};
+            if (vtable_->submit_if_ready(shared_state_.get(), slot))
+            {
+                return slot.read();
+            }
+
+            return std::nullopt;
+        }
+
+        [[nodiscard]] auto read() -> asio::awaitable<T, Executor>
+        {
+            return detail::select_transformed<T, Executor>(
+                [](auto&& result)
+                {
+                    return std::move(result).template get_received<T>();
+                },
+                read_op());
+        }
+
+        [[nodiscard]] friend auto operator==(
+            basic_any_read_channel const& lhs,
+            basic_any_read_channel const& rhs) noexcept -> bool
+        {
+            return lhs.shared_state_ == rhs.shared_state_;
+        }
+
+      private:
+        template <sendable_value, asio::execution::executor, std::size_t>
+        friend class detail::any_channel_op_base;
+
+        std::shared_ptr<void> shared_state_;
+        detail::any_channel_vtable<T, Executor> const* vtable_;
+    };
+
+    // A write handle to any writable channel of T, regardless of its buffer size and policy.
+    template <sendable_value T, asio::execution::executor Executor>
+    class basic_any_write_channel
+    {
+      public:
+        using executor_type = Executor;
+        using send_type = T;
+
+        // clang-format off
+        template <any_writable_channel_type Channel>
+        requires std::same_as<typename Channel::send_type, T>
+                 and std::same_as<typename Channel::executor_type, Executor>
+        [[nodiscard]] basic_any_write_channel(Channel const& channel)
+          // clang-format on
+          : shared_state_{channel.shared_state_ptr()}
+          , vtable_{&detail::any_write_channel_vtable<typename Channel::shared_state_type, T, Executor>}
+        {
+        }
+
+        // A write operation, for use in select.
+        [[nodiscard]] auto write_op(T value) const noexcept -> ops::any_write<T, Executor>
+        {
+            return ops::any_write<T, Executor>{std::move(value), *this};
+        }
+
+        // Writes to an unbounded channel always succeed.
+        [[nodiscard]] auto try_write(T value) -> bool
+        {
+            auto slot = detail::send_slot<T>{};
+            slot.write(std::move(value));
+
+            return vtable_->submit_if_ready(shared_state_.get(), slot);
+        }
+
+        [[nodiscard]] auto write(T value) -> asio::awaitable<void, Executor>
+        {
+            return detail::select_transformed<void, Executor>(
+                [](auto&&) {},
+                write_op(std::move(value)));
+        }
+
+        [[nodiscard]] friend auto operator==(
+            basic_any_write_channel const& lhs,
+            basic_any_write_channel const& rhs) noexcept -> bool
+        {
+            return lhs.shared_state_ == rhs.shared_state_;
+        }
+
+      private:
+        template <sendable_value, asio::execution::executor, std::size_t>
+        friend class detail::any_channel_op_base;
+
+        std::shared_ptr<void> shared_state_;
+        detail::any_channel_vtable<T, Executor> const* vtable_;
+    };
+
+    template <sendable_value T>
+    using any_read_channel = basic_any_read_channel<T, asio::any_io_executor>;
+
+    template <sendable_value T>
+    using any_write_channel = basic_any_write_channel<T, asio::any_io_executor>;
+}  // namespace asiochan
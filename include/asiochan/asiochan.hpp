@@ -1,12 +1,30 @@
 #pragma once
 
+#include "asiochan/adaptive_spin.hpp"
+#include "asiochan/any_channel.hpp"
 #include "asiochan/asio.hpp"
 #include "asiochan/async_promise.hpp"
+#include "asiochan/byte_channel.hpp"
 #include "asiochan/channel.hpp"
 #include "asiochan/channel_buff_size.hpp"
 #include "asiochan/channel_concepts.hpp"
+#include "asiochan/channel_loan.hpp"
+#include "asiochan/channel_policy.hpp"
+#include "asiochan/channel_registry.hpp"
+#include "asiochan/channel_stats.hpp"
+#include "asiochan/channel_trace.hpp"
+#include "asiochan/frame_pool.hpp"
+#include "asiochan/lock_profile.hpp"
+#include "asiochan/merge_channels.hpp"
 #include "asiochan/nothing_op.hpp"
+#include "asiochan/numa_allocator.hpp"
+#include "asiochan/pipeline.hpp"
 #include "asiochan/read_op.hpp"
 #include "asiochan/select.hpp"
 #include "asiochan/sendable.hpp"
+#include "asiochan/sharded_channel.hpp"
+#include "asiochan/single_threaded_mutex.hpp"
+#include "asiochan/timeout_op.hpp"
+#include "asiochan/timer_wheel.hpp"
+#include "asiochan/work_queue.hpp"
 #include "asiochan/write_op.hpp"
@@ -115,6 +115,42 @@ namespace asiochan
                 std::bind_front(consume_impl(), nullptr));
         }
 
+        // Like set_value, but hints that the waiter continues the current thread of execution.
+        // Use only when the waiter runs on the calling thread or strand.
+        template <std::convertible_to<T> U>
+        void defer_value(U&& value)
+        {
+            assert(valid());
+            auto executor = asio::get_associated_executor(*impl_);
+            asio::defer(
+                std::move(executor),
+                std::bind_front(consume_impl(), nullptr, T{std::forward<U>(value)}));
+        }
+
+        void defer_value() requires std::is_void_v<T>
+        {
+            assert(valid());
+            auto executor = asio::get_associated_executor(*impl_);
+            asio::defer(
+                std::move(executor),
+                std::bind_front(consume_impl(), nullptr));
+        }
+
+        // Resumes the waiter immediately on the calling thread.
+        // Must only be called from within the executor of the waiter.
+        template <std::convertible_to<T> U>
+        void resume_with_value(U&& value)
+        {
+            auto handler = consume_impl();
+            handler(nullptr, T{std::forward<U>(value)});
+        }
+
+        void resume_with_value() requires std::is_void_v<T>
+        {
+            auto handler = consume_impl();
+            handler(nullptr);
+        }
+
         void set_exception(std::exception_ptr error) requires std::default_initializable<T>
         {
             assert(valid());
@@ -147,6 +183,13 @@ namespace asiochan
             set_exception(std::make_exception_ptr(system::system_error{error}));
         }
 
+        // Destroys the waiter without resuming it, like an execution context destroys a handler it never ran.
+        // The waiter may own the promise, so the promise must not be used afterwards.
+        void abandon() noexcept
+        {
+            [[maybe_unused]] auto const handler = consume_impl();
+        }
+
         void reset()
         {
             if (valid())
@@ -155,11 +198,25 @@ namespace asiochan
             }
         }
 
+        [[nodiscard]] auto get_executor() const -> Executor
+        {
+            assert(valid());
+            return asio::get_associated_executor(*impl_);
+        }
+
         [[nodiscard]] auto valid() const noexcept -> bool
         {
             return impl_.has_value();
         }
 
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+        [[nodiscard]] auto get_cancellation_slot() const noexcept
+        {
+            assert(valid());
+            return asio::get_associated_cancellation_slot(*impl_);
+        }
+#endif
+
         [[nodiscard]] auto get_awaitable()
             -> asio::awaitable<T, Executor>
         {
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/send_slot.hpp"
+
+namespace asiochan
+{
+    namespace detail
+    {
+        // A write waiting for space, referring to the buffer sequence in the frame of the writer.
+        struct byte_write_request
+        {
+            void const* buffers = nullptr;
+            std::size_t size = 0;
+            std::size_t (*copy_to)(void const* buffers, std::array<asio::mutable_buffer, 2> const& target) = nullptr;
+        };
+
+        template <typename ConstBufferSequence>
+        auto copy_buffer_sequence(
+            void const* const buffers,
+            std::array<asio::mutable_buffer, 2> const& target)
+            -> std::size_t
+        {
+            return asio::buffer_copy(target, *static_cast<ConstBufferSequence const*>(buffers));
+        }
+
+        template <asio::execution::executor Executor>
+        class byte_channel_state
+        {
+          public:
+            using writer_list_type = channel_waiter_list<byte_write_request, Executor>;
+            using reader_list_type = channel_waiter_list<void, Executor>;
+
+            explicit byte_channel_state(std::size_t const capacity)
+              : data_{new std::byte[capacity]}
+              , capacity_{capacity}
+            {
+                assert(capacity > 0);
+            }
+
+            [[nodiscard]] auto mutex() noexcept -> std::mutex&
+            {
+                return mutex_;
+            }
+
+            [[nodiscard]] auto writer_list() noexcept -> writer_list_type&
+            {
+                return writer_list_;
+            }
+
+            [[nodiscard]] auto reader_list() noexcept -> reader_list_type&
+            {
+                return reader_list_;
+            }
+
+            [[nodiscard]] auto capacity() const noexcept -> std::size_t
+            {
+                return capacity_;
+            }
+
+            [[nodiscard]] auto size() const noexcept -> std::size_t
+            {
+                return size_;
+            }
+
+            // The following methods must be called with the mutex held.
+
+            // Copies the request into the ring, if it fits and no earlier writer is waiting.
+            [[nodiscard]] auto try_write(byte_write_request const& request) -> bool
+            {
+                if (writer_list_.front() or request.size > capacity_ - size_)
+                {
+                    return false;
+                }
+
+                copy_in(request);
+                wake_reader();
+
+                return true;
+            }
+
+            [[nodiscard]] auto readable() const noexcept -> bool
+            {
+                return not reading_ and size_ != 0;
+            }
+
+            // Lends the readable bytes to a single reader, until they are consumed.
+            [[nodiscard]] auto acquire() noexcept -> std::array<asio::const_buffer, 2>
+            {
+                assert(readable());
+                reading_ = true;
+
+                auto const first_size = std::min(size_, capacity_ - head_);
+                return {
+                    asio::const_buffer{data_.get() + head_, first_size},
+                    asio::const_buffer{data_.get(), size_ - first_size},
+                };
+            }
+
+            void consume(std::size_t const num_bytes) noexcept
+            {
+                assert(reading_ and num_bytes <= size_);
+                reading_ = false;
+                head_ = (head_ + num_bytes) % capacity_;
+                size_ -= num_bytes;
+
+                // Writers are served in order, as long as their data fits.
+                while (true)
+                {
+                    auto const writer = writer_list_.front();
+                    if (not writer or writer->slot->get().size > capacity_ - size_)
+                    {
+                        break;
+                    }
+
+                    [[maybe_unused]] auto const claimed = writer_list_.dequeue_first_available();
+                    assert(claimed == writer);
+                    copy_in(writer->slot->get());
+                    notify_waiter(*claimed);
+                }
+
+                wake_reader();
+            }
+
+          private:
+            std::mutex mutex_;
+            writer_list_type writer_list_;
+            reader_list_type reader_list_;
+            std::unique_ptr<std::byte[]> data_;
+            std::size_t capacity_ = 0;
+            std::size_t head_ = 0;
+            std::size_t size_ = 0;
+            bool reading_ = false;
+
+            void copy_in(byte_write_request const& request) noexcept
+            {
+                auto const tail = (head_ + size_) % capacity_;
+                auto const first_size = std::min(request.size, capacity_ - tail);
+                auto const target = std::array{
+                    asio::mutable_buffer{data_.get() + tail, first_size},
+                    asio::mutable_buffer{data_.get(), request.size - first_size},
+                };
+
+                [[maybe_unused]] auto const num_copied = request.copy_to(request.buffers, target);
+                assert(num_copied == request.size);
+                size_ += request.size;
+            }
+
+            void wake_reader() noexcept
+            {
+                if (readable())
+                {
+                    if (auto const reader = reader_list_.dequeue_first_available())
+                    {
+                        notify_waiter(*reader);
+                    }
+                }
+            }
+        };
+    }  // namespace detail
+
+    // The bytes lent to a reader of a byte channel.
+    // Destroying the view without calling consume consumes all of its bytes.
+    template <asio::execution::executor Executor>
+    class basic_byte_channel_view
+    {
+      public:
+        basic_byte_channel_view(
+            std::shared_ptr<detail::byte_channel_state<Executor>> state,
+            std::array<asio::const_buffer, 2> const& buffers) noexcept
+          : state_{std::move(state)}
+          , buffers_{buffers}
+        {
+        }
+
+        basic_byte_channel_view(basic_byte_channel_view&& other) noexcept
+          : state_{std::move(other.state_)}
+          , buffers_{other.buffers_}
+        {
+        }
+
+        auto operator=(basic_byte_channel_view&& other) noexcept -> basic_byte_channel_view&
+        {
+            if (this != &other)
+            {
+                consume(size());
+                state_ = std::move(other.state_);
+                buffers_ = other.buffers_;
+            }
+
+            return *this;
+        }
+
+        ~basic_byte_channel_view() noexcept
+        {
+            consume(size());
+        }
+
+        // A buffer sequence over the lent bytes, valid until the view is consumed.
+        [[nodiscard]] auto buffers() const noexcept -> std::span<asio::const_buffer const>
+        {
+            return {buffers_.data(), buffers_[1].size() != 0 ? 2u : 1u};
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t
+        {
+            return buffers_[0].size() + buffers_[1].size();
+        }
+
+        // Frees the first bytes of the view for writers. The remaining bytes are read again by the next reader.
+        void consume(std::size_t const num_bytes) noexcept
+        {
+            if (not state_)
+            {
+                return;
+            }
+
+            auto const lock = std::scoped_lock{state_->mutex()};
+            state_->consume(num_bytes);
+            state_.reset();
+        }
+
+      private:
+        std::shared_ptr<detail::byte_channel_state<Executor>> state_;
+        std::array<asio::const_buffer, 2> buffers_;
+    };
+
+    // A channel of bytes, backed by a contiguous ring buffer.
+    // Writes are never split, and never reordered. Readers are lent the buffered bytes in place.
+    template <asio::execution::executor Executor>
+    class basic_byte_channel
+    {
+      public:
+        using executor_type = Executor;
+        using view_type = basic_byte_channel_view<Executor>;
+
+        [[nodiscard]] explicit basic_byte_channel(std::size_t const capacity)
+          : state_{std::make_shared<state_type>(capacity)}
+        {
+        }
+
+        [[nodiscard]] auto capacity() const noexcept -> std::size_t
+        {
+            return state_->capacity();
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            auto const lock = std::scoped_lock{state_->mutex()};
+            return state_->size();
+        }
+
+        // clang-format off
+        template <typename ConstBufferSequence>
+        requires asio::is_const_buffer_sequence<ConstBufferSequence>::value
+        [[nodiscard]] auto try_write(ConstBufferSequence const& buffers) -> bool
+        // clang-format on
+        {
+            auto const request = make_request(buffers);
+            auto const lock = std::scoped_lock{state_->mutex()};
+
+            return state_->try_write(request);
+        }
+
+        // clang-format off
+        template <typename ConstBufferSequence>
+        requires asio::is_const_buffer_sequence<ConstBufferSequence>::value
+        [[nodiscard]] auto write(ConstBufferSequence buffers) -> asio::awaitable<void, Executor>
+        // clang-format on
+        {
+            auto const request = make_request(buffers);
+            auto const state = state_;
+            auto slot = detail::send_slot<detail::byte_write_request>{};
+            auto waiter_node = detail::channel_waiter_list_node<detail::byte_write_request, Executor>{};
+            waiter_node.slot = &slot;
+
+            // A parked writer is resumed once a reader has copied its data into the ring.
+            co_await detail::wait_in_list<Executor>(
+                state->mutex(),
+                state->writer_list(),
+                waiter_node,
+                [&]()
+                {
+                    if (state->try_write(request))
+                    {
+                        return true;
+                    }
+
+                    slot.write(detail::byte_write_request{request});
+                    return false;
+                });
+        }
+
+        [[nodiscard]] auto try_read_some() -> std::optional<view_type>
+        {
+            auto const lock = std::scoped_lock{state_->mutex()};
+            if (not state_->readable())
+            {
+                return std::nullopt;
+            }
+
+            return view_type{state_, state_->acquire()};
+        }
+
+        [[nodiscard]] auto read_some() -> asio::awaitable<view_type, Executor>
+        {
+            auto const state = state_;
+            while (true)
+            {
+                if (auto view = try_read_some())
+                {
+                    co_return std::move(*view);
+                }
+
+                // Readers are woken one at a time, and retry.
+                auto waiter_node = detail::channel_waiter_list_node<void, Executor>{};
+                co_await detail::wait_in_list<Executor>(
+                    state->mutex(),
+                    state->reader_list(),
+                    waiter_node,
+                    [&]()
+                    {
+                        return state->readable();
+                    });
+            }
+        }
+
+        [[nodiscard]] friend auto operator==(
+            basic_byte_channel const& lhs,
+            basic_byte_channel const& rhs) noexcept -> bool
+            = default;
+
+      private:
+        using state_type = detail::byte_channel_state<Executor>;
+
+        std::shared_ptr<state_type> state_;
+
+        template <typename ConstBufferSequence>
+        [[nodiscard]] auto make_request(ConstBufferSequence const& buffers) const -> detail::byte_write_request
+        {
+            auto const size = asio::buffer_size(buffers);
+            if (size > capacity())
+            {
+                throw std::length_error{"byte channel write exceeds the channel capacity"};
+            }
+
+            return {
+                .buffers = &buffers,
+                .size = size,
+                .copy_to = &detail::copy_buffer_sequence<ConstBufferSequence>,
+            };
+        }
+    };
+
+    using byte_channel = basic_byte_channel<asio::any_io_executor>;
+    using byte_channel_view = basic_byte_channel_view<asio::any_io_executor>;
+}  // namespace asiochan
@@ -2,10 +2,14 @@
 
 #include <concepts>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "asiochan/asio.hpp"
 #include "asiochan/channel_buff_size.hpp"
 #include "asiochan/channel_concepts.hpp"
+#include "asiochan/channel_policy.hpp"
+#include "asiochan/channel_stats.hpp"
 #include "asiochan/detail/channel_method_ops.hpp"
 #include "asiochan/detail/channel_shared_state.hpp"
 #include "asiochan/sendable.hpp"
@@ -15,18 +19,34 @@ namespace asiochan
     template <sendable T,
               channel_buff_size buff_size,
               channel_flags flags_,
-              asio::execution::executor Executor>
+              asio::execution::executor Executor,
+              typename Policy = default_channel_policy>
     class channel_base
     {
       public:
         using executor_type = Executor;
-        using shared_state_type = detail::channel_shared_state<T, Executor, buff_size>;
+        using shared_state_type = detail::channel_shared_state<T, Executor, buff_size, Policy>;
         using send_type = T;
+        using policy_type = Policy;
+        using allocator_type = typename channel_policy_traits<Policy>::allocator_type;
 
         static constexpr auto flags = flags_;
 
         [[nodiscard]] channel_base()
-          : shared_state_{std::make_shared<shared_state_type>()}
+          : shared_state_{std::allocate_shared<shared_state_type>(allocator_type{})}
+        {
+        }
+
+        [[nodiscard]] channel_base(std::allocator_arg_t, allocator_type const& allocator)
+          : shared_state_{std::allocate_shared<shared_state_type>(allocator)}
+        {
+        }
+
+        // clang-format off
+        [[nodiscard]] explicit channel_base(std::string name)
+        requires shared_state_type::registered
+          // clang-format on
+          : shared_state_{std::allocate_shared<shared_state_type>(allocator_type{}, std::move(name))}
         {
         }
 
@@ -34,7 +54,7 @@ namespace asiochan
         template <channel_flags other_flags>
         requires ((other_flags & flags) == flags)
         [[nodiscard]] channel_base(
-            channel_base<T, buff_size, other_flags, Executor> const& other)
+            channel_base<T, buff_size, other_flags, Executor, Policy> const& other)
           : shared_state_{other.shared_state_}
         // clang-format on
         {
@@ -44,17 +64,30 @@ namespace asiochan
         template <channel_flags other_flags>
         requires ((other_flags & flags) == flags)
         [[nodiscard]] channel_base(
-            channel_base<T, buff_size, other_flags, Executor>&& other)
+            channel_base<T, buff_size, other_flags, Executor, Policy>&& other)
           : shared_state_{std::move(other.shared_state_)}
         // clang-format on
         {
         }
 
-        [[nodiscard]] auto shared_state() noexcept -> shared_state_type&
+        [[nodiscard]] auto shared_state() const noexcept -> shared_state_type&
         {
             return *shared_state_;
         }
 
+        [[nodiscard]] auto shared_state_ptr() const noexcept -> std::shared_ptr<shared_state_type> const&
+        {
+            return shared_state_;
+        }
+
+        // clang-format off
+        [[nodiscard]] auto stats() const -> channel_stats_snapshot
+        requires shared_state_type::has_stats
+        // clang-format on
+        {
+            return shared_state_->stats_snapshot();
+        }
+
         [[nodiscard]] friend auto operator==(
             channel_base const& lhs,
             channel_base const& rhs) noexcept -> bool
@@ -64,20 +97,23 @@ namespace asiochan
         ~channel_base() noexcept = default;
 
       private:
-        template <sendable, channel_buff_size, channel_flags, asio::execution::executor>
+        template <sendable, channel_buff_size, channel_flags, asio::execution::executor, typename>
         friend class channel_base;
 
         std::shared_ptr<shared_state_type> shared_state_;
     };
 
-    template <sendable T, channel_buff_size buff_size, asio::execution::executor Executor>
+    template <sendable T,
+              channel_buff_size buff_size,
+              asio::execution::executor Executor,
+              typename Policy = default_channel_policy>
     class basic_channel
-      : public channel_base<T, buff_size, bidirectional, Executor>,
-        public detail::channel_method_ops<T, Executor, buff_size, bidirectional, basic_channel<T, buff_size, Executor>>
+      : public channel_base<T, buff_size, bidirectional, Executor, Policy>,
+        public detail::channel_method_ops<T, Executor, buff_size, bidirectional, basic_channel<T, buff_size, Executor, Policy>>
     {
       private:
-        using base = channel_base<T, buff_size, bidirectional, Executor>;
-        using ops = detail::channel_method_ops<T, Executor, buff_size, bidirectional, basic_channel<T, buff_size, Executor>>;
+        using base = channel_base<T, buff_size, bidirectional, Executor, Policy>;
+        using ops = detail::channel_method_ops<T, Executor, buff_size, bidirectional, basic_channel<T, buff_size, Executor, Policy>>;
 
       public:
         using base::base;
@@ -86,19 +122,30 @@ namespace asiochan
 
         using ops::read;
 
+        using ops::async_read;
+
+        using ops::blocking_read;
+
         using ops::try_write;
 
         using ops::write;
+
+        using ops::async_write;
+
+        using ops::blocking_write;
     };
 
-    template <sendable T, channel_buff_size buff_size, asio::execution::executor Executor>
+    template <sendable T,
+              channel_buff_size buff_size,
+              asio::execution::executor Executor,
+              typename Policy = default_channel_policy>
     class basic_read_channel
-      : public channel_base<T, buff_size, readable, Executor>,
-        public detail::channel_method_ops<T, Executor, buff_size, readable, basic_read_channel<T, buff_size, Executor>>
+      : public channel_base<T, buff_size, readable, Executor, Policy>,
+        public detail::channel_method_ops<T, Executor, buff_size, readable, basic_read_channel<T, buff_size, Executor, Policy>>
     {
       private:
-        using base = channel_base<T, buff_size, readable, Executor>;
-        using ops = detail::channel_method_ops<T, Executor, buff_size, readable, basic_read_channel<T, buff_size, Executor>>;
+        using base = channel_base<T, buff_size, readable, Executor, Policy>;
+        using ops = detail::channel_method_ops<T, Executor, buff_size, readable, basic_read_channel<T, buff_size, Executor, Policy>>;
 
       public:
         using base::base;
@@ -106,16 +153,23 @@ namespace asiochan
         using ops::try_read;
 
         using ops::read;
+
+        using ops::async_read;
+
+        using ops::blocking_read;
     };
 
-    template <sendable T, channel_buff_size buff_size, asio::execution::executor Executor>
+    template <sendable T,
+              channel_buff_size buff_size,
+              asio::execution::executor Executor,
+              typename Policy = default_channel_policy>
     class basic_write_channel
-      : public channel_base<T, buff_size, writable, Executor>,
-        public detail::channel_method_ops<T, Executor, buff_size, writable, basic_write_channel<T, buff_size, Executor>>
+      : public channel_base<T, buff_size, writable, Executor, Policy>,
+        public detail::channel_method_ops<T, Executor, buff_size, writable, basic_write_channel<T, buff_size, Executor, Policy>>
     {
       private:
-        using base = channel_base<T, buff_size, writable, Executor>;
-        using ops = detail::channel_method_ops<T, Executor, buff_size, writable, basic_write_channel<T, buff_size, Executor>>;
+        using base = channel_base<T, buff_size, writable, Executor, Policy>;
+        using ops = detail::channel_method_ops<T, Executor, buff_size, writable, basic_write_channel<T, buff_size, Executor, Policy>>;
 
       public:
         using base::base;
@@ -123,6 +177,10 @@ namespace asiochan
         using ops::try_write;
 
         using ops::write;
+
+        using ops::async_write;
+
+        using ops::blocking_write;
     };
 
     template <sendable T, channel_buff_size buff_size = 0>
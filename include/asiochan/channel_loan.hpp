@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "asiochan/channel_stats.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+
+namespace asiochan
+{
+    namespace detail
+    {
+        // Hands values to parked readers, and buffer slots to parked writers,
+        // after a loan changed the state of the buffer. Must be called with the mutex held.
+        template <typename ChannelState>
+        void serve_parked_waiters(ChannelState& channel_state) noexcept
+        {
+            auto& buffer = channel_state.buffer();
+            while (true)
+            {
+                if (not buffer.empty())
+                {
+                    if (auto const reader = channel_state.reader_list().dequeue_first_available())
+                    {
+                        buffer.dequeue(*reader->slot);
+                        channel_state.trace_read_dequeued();
+                        channel_state.trace_waiter_woken(channel_op_kind::read);
+                        notify_waiter(*reader);
+                        continue;
+                    }
+                }
+
+                if (not buffer.full())
+                {
+                    if (auto const writer = channel_state.writer_list().dequeue_first_available())
+                    {
+                        buffer.enqueue(*writer->slot);
+                        channel_state.trace_buffer_enqueued(*writer);
+                        channel_state.trace_waiter_woken(channel_op_kind::write);
+                        notify_waiter(*writer);
+                        continue;
+                    }
+                }
+
+                return;
+            }
+        }
+    }  // namespace detail
+
+    // A buffer slot reserved for writing. The value is delivered to readers once committed.
+    // Destroying an uncommitted loan abandons the reservation.
+    template <typename Channel>
+    class write_loan
+    {
+      public:
+        using send_type = typename Channel::send_type;
+
+        write_loan(Channel channel, std::size_t const index) noexcept
+          : channel_{std::move(channel)}
+          , index_{index}
+        {
+        }
+
+        write_loan(write_loan&& other) noexcept
+          : channel_{std::move(other.channel_)}
+          , index_{std::exchange(other.index_, std::nullopt)}
+        {
+        }
+
+        auto operator=(write_loan&& other) noexcept -> write_loan&
+        {
+            if (this != &other)
+            {
+                abandon();
+                channel_ = std::move(other.channel_);
+                index_ = std::exchange(other.index_, std::nullopt);
+            }
+
+            return *this;
+        }
+
+        ~write_loan() noexcept
+        {
+            abandon();
+        }
+
+        [[nodiscard]] auto get() const noexcept -> send_type&
+        {
+            assert(valid());
+            return channel_.shared_state().buffer().get(*index_);
+        }
+
+        [[nodiscard]] auto operator*() const noexcept -> send_type&
+        {
+            return get();
+        }
+
+        [[nodiscard]] auto operator->() const noexcept -> send_type*
+        {
+            return &get();
+        }
+
+        void commit() noexcept
+        {
+            assert(valid());
+            auto& channel_state = channel_.shared_state();
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            channel_state.buffer().commit(*std::exchange(index_, std::nullopt));
+            channel_state.trace_buffer_enqueued();
+            detail::serve_parked_waiters(channel_state);
+        }
+
+        [[nodiscard]] auto valid() const noexcept -> bool
+        {
+            return index_.has_value();
+        }
+
+      private:
+        Channel channel_;
+        std::optional<std::size_t> index_;
+
+        void abandon() noexcept
+        {
+            if (not valid())
+            {
+                return;
+            }
+
+            auto& channel_state = channel_.shared_state();
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            channel_state.buffer().release(*std::exchange(index_, std::nullopt));
+            // Abandoning the oldest reservation may expose later committed values.
+            channel_state.trace_buffer_enqueued();
+            detail::serve_parked_waiters(channel_state);
+        }
+    };
+
+    // A buffered value lent to a reader. Its slot is freed once released.
+    // Destroying the loan releases it.
+    template <typename Channel>
+    class read_loan
+    {
+      public:
+        using send_type = typename Channel::send_type;
+
+        read_loan(Channel channel, std::size_t const index) noexcept
+          : channel_{std::move(channel)}
+          , index_{index}
+        {
+        }
+
+        read_loan(read_loan&& other) noexcept
+          : channel_{std::move(other.channel_)}
+          , index_{std::exchange(other.index_, std::nullopt)}
+        {
+        }
+
+        auto operator=(read_loan&& other) noexcept -> read_loan&
+        {
+            if (this != &other)
+            {
+                release();
+                channel_ = std::move(other.channel_);
+                index_ = std::exchange(other.index_, std::nullopt);
+            }
+
+            return *this;
+        }
+
+        ~read_loan() noexcept
+        {
+            release();
+        }
+
+        [[nodiscard]] auto get() const noexcept -> send_type&
+        {
+            assert(valid());
+            return channel_.shared_state().buffer().get(*index_);
+        }
+
+        [[nodiscard]] auto operator*() const noexcept -> send_type&
+        {
+            return get();
+        }
+
+        [[nodiscard]] auto operator->() const noexcept -> send_type*
+        {
+            return &get();
+        }
+
+        void release() noexcept
+        {
+            if (not valid())
+            {
+                return;
+            }
+
+            auto& channel_state = channel_.shared_state();
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            channel_state.buffer().release(*std::exchange(index_, std::nullopt));
+            detail::serve_parked_waiters(channel_state);
+        }
+
+        [[nodiscard]] auto valid() const noexcept -> bool
+        {
+            return index_.has_value();
+        }
+
+      private:
+        Channel channel_;
+        std::optional<std::size_t> index_;
+    };
+}  // namespace asiochan
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "asiochan/channel_stats.hpp"
+#include "asiochan/channel_trace.hpp"
+#include "asiochan/lock_profile.hpp"
+#include "asiochan/numa_allocator.hpp"
+#include "asiochan/single_threaded_mutex.hpp"
+
+namespace asiochan
+{
+    // Policies customize the shared state of a channel at compile time.
+    // Every member is optional, missing members fall back to the defaults.
+    struct default_channel_policy
+    {
+    };
+
+    struct instrumented_channel_policy
+    {
+        using stats_type = channel_stats;
+    };
+
+    struct registered_channel_policy
+    {
+        static constexpr bool registered = true;
+    };
+
+    struct profiled_channel_policy
+    {
+        using stats_type = channel_stats;
+        using mutex_type = profiled_mutex;
+    };
+
+    struct traced_channel_policy
+    {
+        using tracer_type = channel_tracer;
+    };
+
+    // Places the shared state and buffer of a channel on the NUMA node given to its constructor.
+    struct numa_channel_policy
+    {
+        using allocator_type = numa_allocator<std::byte>;
+    };
+
+    // Enables lending buffer slots to writers and readers, see reserve and acquire.
+    struct loan_channel_policy
+    {
+        static constexpr bool loans = true;
+    };
+
+    // For channels whose writers wake many readers on another executor.
+    struct batched_wakeup_channel_policy
+    {
+        static constexpr bool batch_wakeups = true;
+    };
+
+    // For channels confined to one thread or strand, together with all of their readers and writers.
+    struct single_threaded_channel_policy
+    {
+        using mutex_type = single_threaded_mutex;
+        static constexpr bool single_threaded = true;
+    };
+
+    namespace detail
+    {
+        template <typename Policy>
+        struct policy_stats_type
+        {
+            using type = no_channel_stats;
+        };
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { typename Policy::stats_type; }
+        struct policy_stats_type<Policy>
+        // clang-format on
+        {
+            using type = typename Policy::stats_type;
+        };
+
+        template <typename Policy>
+        struct policy_mutex_type
+        {
+            using type = std::mutex;
+        };
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { typename Policy::mutex_type; }
+        struct policy_mutex_type<Policy>
+        // clang-format on
+        {
+            using type = typename Policy::mutex_type;
+        };
+
+        template <typename Policy>
+        struct policy_tracer_type
+        {
+            using type = no_channel_tracer;
+        };
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { typename Policy::tracer_type; }
+        struct policy_tracer_type<Policy>
+        // clang-format on
+        {
+            using type = typename Policy::tracer_type;
+        };
+
+        template <typename Policy>
+        struct policy_allocator_type
+        {
+            using type = std::allocator<std::byte>;
+        };
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { typename Policy::allocator_type; }
+        struct policy_allocator_type<Policy>
+        // clang-format on
+        {
+            using type = typename Policy::allocator_type;
+        };
+
+        template <typename Policy>
+        inline constexpr bool policy_registered = false;
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { { Policy::registered } -> std::convertible_to<bool>; }
+        inline constexpr bool policy_registered<Policy> = Policy::registered;
+        // clang-format on
+
+        template <typename Policy>
+        inline constexpr bool policy_batch_wakeups = false;
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { { Policy::batch_wakeups } -> std::convertible_to<bool>; }
+        inline constexpr bool policy_batch_wakeups<Policy> = Policy::batch_wakeups;
+        // clang-format on
+
+        template <typename Policy>
+        inline constexpr bool policy_loans = false;
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { { Policy::loans } -> std::convertible_to<bool>; }
+        inline constexpr bool policy_loans<Policy> = Policy::loans;
+        // clang-format on
+
+        template <typename Policy>
+        inline constexpr bool policy_single_threaded = false;
+
+        // clang-format off
+        template <typename Policy>
+        requires requires { { Policy::single_threaded } -> std::convertible_to<bool>; }
+        inline constexpr bool policy_single_threaded<Policy> = Policy::single_threaded;
+        // clang-format on
+    }  // namespace detail
+
+    template <typename Policy>
+    struct channel_policy_traits
+    {
+        using stats_type = typename detail::policy_stats_type<Policy>::type;
+        using mutex_type = typename detail::policy_mutex_type<Policy>::type;
+        using tracer_type = typename detail::policy_tracer_type<Policy>::type;
+        using allocator_type = typename detail::policy_allocator_type<Policy>::type;
+
+        static constexpr bool registered = detail::policy_registered<Policy>;
+        static constexpr bool single_threaded = detail::policy_single_threaded<Policy>;
+        static constexpr bool batch_wakeups = detail::policy_batch_wakeups<Policy>;
+        static constexpr bool loans = detail::policy_loans<Policy>;
+    };
+}  // namespace asiochan
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace asiochan
+{
+    struct channel_report
+    {
+        std::string name;
+        std::size_t buffer_size = 0;
+        // Empty for unbounded channels.
+        std::optional<std::size_t> buffer_capacity = std::nullopt;
+        std::size_t parked_readers = 0;
+        std::size_t parked_writers = 0;
+        std::optional<std::chrono::steady_clock::duration> oldest_waiter_age = std::nullopt;
+    };
+
+    class channel_registry;
+
+    namespace detail
+    {
+        struct channel_registry_node
+        {
+            using report_fn = void (*)(void* owner, channel_report& report);
+
+            report_fn on_report = nullptr;
+            void* owner = nullptr;
+            std::string name;
+            channel_registry_node* prev = nullptr;
+            channel_registry_node* next = nullptr;
+        };
+    }  // namespace detail
+
+    class channel_registry
+    {
+      public:
+        channel_registry() noexcept = default;
+
+        channel_registry(channel_registry const&) = delete;
+        auto operator=(channel_registry const&) -> channel_registry& = delete;
+
+        [[nodiscard]] static auto global() noexcept -> channel_registry&
+        {
+            static auto registry = channel_registry{};
+            return registry;
+        }
+
+        [[nodiscard]] auto size() const -> std::size_t
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            return size_;
+        }
+
+        // Reports every live channel, in registration order.
+        // Each channel is locked while it is being reported, channels must not
+        // be created or destroyed from within the callback.
+        template <std::invocable<channel_report const&> Callback>
+        void for_each(Callback&& callback) const
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            for (auto node = first_; node; node = node->next)
+            {
+                auto report = channel_report{.name = node->name};
+                node->on_report(node->owner, report);
+                std::invoke(callback, std::as_const(report));
+            }
+        }
+
+        [[nodiscard]] auto snapshot() const -> std::vector<channel_report>
+        {
+            auto reports = std::vector<channel_report>{};
+            for_each(
+                [&](channel_report const& report)
+                {
+                    reports.push_back(report);
+                });
+
+            return reports;
+        }
+
+        void add(detail::channel_registry_node& node) noexcept
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            node.prev = last_;
+            node.next = nullptr;
+            if (last_)
+            {
+                last_->next = &node;
+            }
+            else
+            {
+                first_ = &node;
+            }
+            last_ = &node;
+            ++size_;
+        }
+
+        void remove(detail::channel_registry_node& node) noexcept
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            (node.prev ? node.prev->next : first_) = node.next;
+            (node.next ? node.next->prev : last_) = node.prev;
+            node.prev = nullptr;
+            node.next = nullptr;
+            --size_;
+        }
+
+      private:
+        mutable std::mutex mutex_;
+        detail::channel_registry_node* first_ = nullptr;
+        detail::channel_registry_node* last_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    namespace detail
+    {
+        template <bool enabled>
+        class channel_registration
+        {
+          public:
+            channel_registration() noexcept = default;
+
+            channel_registration(std::string const&, channel_registry_node::report_fn, void*) noexcept
+            {
+            }
+        };
+
+        template <>
+        class channel_registration<true>
+        {
+          public:
+            channel_registration(
+                std::string name,
+                channel_registry_node::report_fn const on_report,
+                void* const owner)
+            {
+                node_.name = std::move(name);
+                node_.on_report = on_report;
+                node_.owner = owner;
+                channel_registry::global().add(node_);
+            }
+
+            channel_registration(channel_registration const&) = delete;
+            auto operator=(channel_registration const&) -> channel_registration& = delete;
+
+            ~channel_registration()
+            {
+                channel_registry::global().remove(node_);
+            }
+
+          private:
+            channel_registry_node node_;
+        };
+    }  // namespace detail
+}  // namespace asiochan
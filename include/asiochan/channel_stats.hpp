@@ -0,0 +1,195 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "asiochan/lock_profile.hpp"
+
+namespace asiochan
+{
+    enum class channel_op_kind
+    {
+        read,
+        write,
+    };
+
+    class channel_wait_histogram
+    {
+      public:
+        using duration = std::chrono::steady_clock::duration;
+
+        // Bucket 0 counts waits below 1us, bucket i counts waits in [2^(i-1), 2^i) us.
+        // The last bucket also counts all longer waits.
+        static constexpr auto num_buckets = std::size_t{24};
+
+        std::array<std::uint64_t, num_buckets> counts = {};
+
+        [[nodiscard]] static auto bucket_of(duration const wait_time) noexcept -> std::size_t
+        {
+            auto const micros = std::chrono::duration_cast<std::chrono::microseconds>(wait_time).count();
+            if (micros <= 0)
+            {
+                return 0;
+            }
+
+            auto const bucket = static_cast<std::size_t>(std::bit_width(static_cast<std::uint64_t>(micros)));
+            return bucket < num_buckets ? bucket : num_buckets - 1;
+        }
+
+        [[nodiscard]] static auto bucket_upper_bound(std::size_t const bucket) noexcept -> duration
+        {
+            if (bucket + 1 >= num_buckets)
+            {
+                return duration::max();
+            }
+
+            return std::chrono::microseconds{std::uint64_t{1} << bucket};
+        }
+
+        [[nodiscard]] auto total() const noexcept -> std::uint64_t
+        {
+            auto sum = std::uint64_t{0};
+            for (auto const count : counts)
+            {
+                sum += count;
+            }
+
+            return sum;
+        }
+    };
+
+    struct channel_op_stats
+    {
+        std::uint64_t completed = 0;
+        std::uint64_t waitfree = 0;
+        std::uint64_t suspended = 0;
+        std::size_t parked = 0;
+        channel_wait_histogram wait_times = {};
+    };
+
+    struct channel_stats_snapshot
+    {
+        std::size_t buffer_size = 0;
+        std::size_t peak_buffer_size = 0;
+        channel_op_stats reads = {};
+        channel_op_stats writes = {};
+        lock_stats lock = {};
+    };
+
+    class no_channel_stats
+    {
+      public:
+        static constexpr bool enabled = false;
+
+        static void record_waitfree(channel_op_kind) noexcept { }
+
+        static void record_wakeup(channel_op_kind, std::chrono::steady_clock::duration) noexcept { }
+
+        static void record_buffer_size(std::size_t) noexcept { }
+    };
+
+    class channel_stats
+    {
+      public:
+        static constexpr bool enabled = true;
+
+        void record_waitfree(channel_op_kind const kind) noexcept
+        {
+            counters(kind).waitfree.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void record_wakeup(channel_op_kind const kind, std::chrono::steady_clock::duration const wait_time) noexcept
+        {
+            auto& op_counters = counters(kind);
+            op_counters.suspended.fetch_add(1, std::memory_order_relaxed);
+            op_counters.wait_times[channel_wait_histogram::bucket_of(wait_time)].fetch_add(
+                1,
+                std::memory_order_relaxed);
+        }
+
+        // Must be called with the channel mutex held.
+        void record_buffer_size(std::size_t const size) noexcept
+        {
+            if (size > peak_buffer_size_.load(std::memory_order_relaxed))
+            {
+                peak_buffer_size_.store(size, std::memory_order_relaxed);
+            }
+        }
+
+        void load(channel_stats_snapshot& snapshot) const noexcept
+        {
+            snapshot.peak_buffer_size = peak_buffer_size_.load(std::memory_order_relaxed);
+            read_counters_.load(snapshot.reads);
+            write_counters_.load(snapshot.writes);
+        }
+
+      private:
+        struct op_counters
+        {
+            std::atomic<std::uint64_t> waitfree = 0;
+            std::atomic<std::uint64_t> suspended = 0;
+            std::array<std::atomic<std::uint64_t>, channel_wait_histogram::num_buckets> wait_times = {};
+
+            void load(channel_op_stats& stats) const noexcept
+            {
+                stats.waitfree = waitfree.load(std::memory_order_relaxed);
+                stats.suspended = suspended.load(std::memory_order_relaxed);
+                stats.completed = stats.waitfree + stats.suspended;
+
+                for (auto i = std::size_t{0}; i < channel_wait_histogram::num_buckets; ++i)
+                {
+                    stats.wait_times.counts[i] = wait_times[i].load(std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::atomic<std::size_t> peak_buffer_size_ = 0;
+        op_counters read_counters_;
+        op_counters write_counters_;
+
+        [[nodiscard]] auto counters(channel_op_kind const kind) noexcept -> op_counters&
+        {
+            return kind == channel_op_kind::read ? read_counters_ : write_counters_;
+        }
+    };
+
+    namespace detail
+    {
+        template <bool enabled>
+        class channel_wait_stamp
+        {
+          public:
+            void start() noexcept { }
+
+            [[nodiscard]] static auto elapsed() noexcept -> std::chrono::steady_clock::duration
+            {
+                return {};
+            }
+        };
+
+        template <>
+        class channel_wait_stamp<true>
+        {
+          public:
+            void start() noexcept
+            {
+                if (start_ == std::chrono::steady_clock::time_point{})
+                {
+                    start_ = std::chrono::steady_clock::now();
+                }
+            }
+
+            [[nodiscard]] auto elapsed() const noexcept -> std::chrono::steady_clock::duration
+            {
+                return std::chrono::steady_clock::now() - start_;
+            }
+
+          private:
+            std::chrono::steady_clock::time_point start_ = {};
+        };
+    }  // namespace detail
+}  // namespace asiochan
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "asiochan/channel_stats.hpp"
+
+namespace asiochan
+{
+    // Tracer hooks are called with the channel mutex held, so a tracer needs no synchronization of its own.
+    class no_channel_tracer
+    {
+      public:
+        static constexpr bool enabled = false;
+
+        using time_point = std::chrono::steady_clock::time_point;
+
+        static void on_write_enqueued(time_point) noexcept { }
+
+        static void on_read_dequeued(time_point) noexcept { }
+
+        static void on_waiter_parked(channel_op_kind, time_point) noexcept { }
+
+        static void on_waiter_woken(channel_op_kind, time_point) noexcept { }
+    };
+
+    enum class channel_trace_event_kind
+    {
+        write_enqueued,
+        read_dequeued,
+        waiter_parked,
+        waiter_woken,
+    };
+
+    struct channel_trace_event
+    {
+        channel_trace_event_kind kind;
+        channel_op_kind op;
+        std::chrono::steady_clock::time_point time;
+        // Messages leave a channel in the order they entered it, so the sequence
+        // number of an enqueue matches the sequence number of its dequeue.
+        std::uint64_t sequence;
+        void const* channel;
+    };
+
+    class channel_trace_log
+    {
+      public:
+        channel_trace_log() = default;
+
+        channel_trace_log(channel_trace_log const&) = delete;
+        auto operator=(channel_trace_log const&) -> channel_trace_log& = delete;
+
+        [[nodiscard]] static auto global() noexcept -> channel_trace_log&
+        {
+            static auto log = channel_trace_log{};
+            return log;
+        }
+
+        void record(channel_trace_event const& event)
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            events_.push_back(event);
+        }
+
+        [[nodiscard]] auto events() const -> std::vector<channel_trace_event>
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            return events_;
+        }
+
+        void clear()
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            events_.clear();
+        }
+
+        // Writes the log in the Chrome trace event format, loadable by chrome://tracing and Perfetto.
+        // Every message becomes an async span from enqueue to dequeue, with one category per channel,
+        // parking and waking are instant events.
+        void write_chrome_trace(std::ostream& out) const
+        {
+            auto const events = this->events();
+            auto const origin = events.empty() ? std::chrono::steady_clock::time_point{} : events.front().time;
+            auto const to_micros = [&](std::chrono::steady_clock::duration const time)
+            {
+                return std::chrono::duration<double, std::micro>{time}.count();
+            };
+
+            auto channel_ids = std::unordered_map<void const*, std::size_t>{};
+            auto enqueue_times = std::unordered_map<
+                void const*,
+                std::unordered_map<std::uint64_t, std::chrono::steady_clock::time_point>>{};
+            auto first = true;
+
+            out << R"({"traceEvents":[)";
+            for (auto const& event : events)
+            {
+                auto const channel_id = channel_ids.try_emplace(event.channel, channel_ids.size() + 1).first->second;
+                auto const write_separator = [&]()
+                {
+                    out << (std::exchange(first, false) ? "\n" : ",\n");
+                };
+
+                switch (event.kind)
+                {
+                case channel_trace_event_kind::write_enqueued:
+                    enqueue_times[event.channel][event.sequence] = event.time;
+                    break;
+                case channel_trace_event_kind::read_dequeued:
+                {
+                    auto& channel_enqueue_times = enqueue_times[event.channel];
+                    auto const enqueued = channel_enqueue_times.find(event.sequence);
+                    if (enqueued == channel_enqueue_times.end())
+                    {
+                        break;
+                    }
+
+                    // Messages in flight overlap without nesting, so they are async spans keyed by
+                    // their sequence number rather than complete events on the channel's track.
+                    auto const write_span_event = [&](char const phase, std::chrono::steady_clock::time_point const time)
+                    {
+                        write_separator();
+                        out << R"({"name":"message )" << event.sequence
+                            << R"(","cat":"asiochan.channel)" << channel_id
+                            << R"(","ph":")" << phase
+                            << R"(","id":)" << event.sequence
+                            << R"(,"pid":1,"tid":)" << channel_id
+                            << R"(,"ts":)" << to_micros(time - origin) << "}";
+                    };
+                    write_span_event('b', enqueued->second);
+                    write_span_event('e', event.time);
+                    channel_enqueue_times.erase(enqueued);
+                    break;
+                }
+                case channel_trace_event_kind::waiter_parked:
+                case channel_trace_event_kind::waiter_woken:
+                    write_separator();
+                    out << R"({"name":")" << (event.op == channel_op_kind::read ? "reader " : "writer ")
+                        << (event.kind == channel_trace_event_kind::waiter_parked ? "parked" : "woken")
+                        << R"(","cat":"asiochan","ph":"i","s":"t","pid":1,"tid":)" << channel_id
+                        << R"(,"ts":)" << to_micros(event.time - origin) << "}";
+                    break;
+                }
+            }
+            out << "\n]}\n";
+        }
+
+      private:
+        mutable std::mutex mutex_;
+        std::vector<channel_trace_event> events_;
+    };
+
+    // Records all events of a channel into the global channel_trace_log.
+    class channel_tracer
+    {
+      public:
+        static constexpr bool enabled = true;
+
+        using time_point = std::chrono::steady_clock::time_point;
+
+        void on_write_enqueued(time_point const time)
+        {
+            record(channel_trace_event_kind::write_enqueued, channel_op_kind::write, time, num_enqueued_++);
+        }
+
+        void on_read_dequeued(time_point const time)
+        {
+            record(channel_trace_event_kind::read_dequeued, channel_op_kind::read, time, num_dequeued_++);
+        }
+
+        void on_waiter_parked(channel_op_kind const op, time_point const time)
+        {
+            record(channel_trace_event_kind::waiter_parked, op, time, 0);
+        }
+
+        void on_waiter_woken(channel_op_kind const op, time_point const time)
+        {
+            record(channel_trace_event_kind::waiter_woken, op, time, 0);
+        }
+
+      private:
+        std::uint64_t num_enqueued_ = 0;
+        std::uint64_t num_dequeued_ = 0;
+
+        void record(
+            channel_trace_event_kind const kind,
+            channel_op_kind const op,
+            time_point const time,
+            std::uint64_t const sequence)
+        {
+            channel_trace_log::global().record({
+                .kind = kind,
+                .op = op,
+                .time = time,
+                .sequence = sequence,
+                .channel = this,
+            });
+        }
+    };
+}  // namespace asiochan
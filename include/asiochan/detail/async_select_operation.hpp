@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/select_impl.hpp"
+#include "asiochan/detail/type_traits.hpp"
+#include "asiochan/frame_pool.hpp"
+#include "asiochan/select_concepts.hpp"
+#include "asiochan/select_result.hpp"
+#include "asiochan/sendable.hpp"
+
+namespace asiochan::detail
+{
+    struct select_result_completion
+    {
+        template <typename Handler, typename Result>
+        void operator()(Handler&& handler, Result&& result) const
+        {
+            std::invoke(std::forward<Handler>(handler), std::forward<Result>(result));
+        }
+    };
+
+    template <sendable T>
+    struct read_completion
+    {
+        template <typename Handler, typename Result>
+        void operator()(Handler&& handler, Result&& result) const
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                std::invoke(std::forward<Handler>(handler));
+            }
+            else
+            {
+                std::invoke(
+                    std::forward<Handler>(handler),
+                    std::forward<Result>(result).template get_received<T>());
+            }
+        }
+    };
+
+    struct write_completion
+    {
+        template <typename Handler, typename Result>
+        void operator()(Handler&& handler, Result&&) const
+        {
+            std::invoke(std::forward<Handler>(handler));
+        }
+    };
+
+    template <typename OpsTuple>
+    struct select_ops_traits;
+
+    template <select_op... Ops>
+    struct select_ops_traits<std::tuple<Ops...>>
+    {
+        using executor_type = typename head_t<Ops...>::executor_type;
+        using result_type = select_result<Ops...>;
+        using wait_states_type = select_wait_states<Ops...>;
+    };
+
+    template <typename Handler, typename Completion, typename Keepalive, typename OpsTuple>
+    class async_select_operation
+      : public select_wait_context<typename select_ops_traits<OpsTuple>::executor_type>
+    {
+      private:
+        using traits_type = select_ops_traits<OpsTuple>;
+        using wait_context_type = select_wait_context<typename traits_type::executor_type>;
+        using handler_executor_type = asio::associated_executor_t<Handler, asio::system_executor>;
+        using work_executor_type = std::decay_t<decltype(asio::prefer(
+            std::declval<handler_executor_type const&>(),
+            asio::execution::outstanding_work.tracked))>;
+        // Operations of handlers without an associated allocator are allocated from the frame pool.
+        using allocator_type = typename std::allocator_traits<
+            asio::associated_allocator_t<Handler, frame_pool_allocator<void>>>::template rebind_alloc<async_select_operation>;
+        using allocator_traits = std::allocator_traits<allocator_type>;
+
+      public:
+        template <typename MakeOps>
+        static void start(Handler handler, Keepalive keepalive, MakeOps make_ops)
+        {
+            auto allocator = allocator_type{asio::get_associated_allocator(handler, frame_pool_allocator<void>{})};
+            auto const ptr = allocator_traits::allocate(allocator, 1);
+
+            auto op = static_cast<async_select_operation*>(nullptr);
+            try
+            {
+                op = ::new (static_cast<void*>(ptr)) async_select_operation{
+                    std::move(handler),
+                    std::move(keepalive),
+                    std::move(make_ops)};
+            }
+            catch (...)
+            {
+                allocator_traits::deallocate(allocator, ptr, 1);
+                throw;
+            }
+
+            op->submit();
+        }
+
+      private:
+        // Invokes the handler from its executor. Posted with the allocator of the operation.
+        struct finish_function
+        {
+            using allocator_type = typename allocator_traits::template rebind_alloc<void>;
+
+            async_select_operation* self;
+            allocator_type allocator;
+
+            [[nodiscard]] auto get_allocator() const noexcept -> allocator_type
+            {
+                return allocator;
+            }
+
+            void operator()() const
+            {
+                finish(*self);
+            }
+        };
+
+        Handler handler_;
+        work_executor_type work_executor_;
+        Keepalive keepalive_;
+        OpsTuple ops_;
+        typename traits_type::wait_states_type ops_wait_states_ = {};
+        std::mutex submit_mutex_;
+        select_waiter_token success_token_ = 0;
+
+        template <typename MakeOps>
+        async_select_operation(Handler&& handler, Keepalive&& keepalive, MakeOps&& make_ops)
+          : handler_{std::move(handler)}
+          , work_executor_{asio::prefer(
+                asio::get_associated_executor(handler_, asio::system_executor{}),
+                asio::execution::outstanding_work.tracked)}
+          , keepalive_{std::move(keepalive)}
+          , ops_{std::invoke(std::move(make_ops), keepalive_)}
+        {
+            this->on_complete = &async_select_operation::on_complete_impl;
+        }
+
+        void submit()
+        {
+            auto ready_token = std::optional<select_waiter_token>{};
+
+            {
+                auto const submit_lock = std::scoped_lock{submit_mutex_};
+                ready_token = std::apply(
+                    [&](auto&... ops_args)
+                    {
+                        return select_submit_with_wait(wait_context(), ops_wait_states_, ops_args...);
+                    },
+                    ops_);
+            }
+
+            if (ready_token)
+            {
+                complete(wait_context(), *ready_token);
+            }
+        }
+
+        [[nodiscard]] auto wait_context() noexcept -> wait_context_type&
+        {
+            return *this;
+        }
+
+        static void on_complete_impl(wait_context_type& ctx, select_waiter_token const token)
+        {
+            auto& self = static_cast<async_select_operation&>(ctx);
+            self.success_token_ = token;
+
+            // Never invoke the handler from the context of the completing operation.
+            asio::post(
+                self.work_executor_,
+                finish_function{
+                    .self = &self,
+                    .allocator = asio::get_associated_allocator(self.handler_, frame_pool_allocator<void>{}),
+                });
+        }
+
+        static void finish(async_select_operation& self)
+        {
+            auto result = [&]()
+            {
+                auto const submit_lock = std::scoped_lock{self.submit_mutex_};
+                return std::apply(
+                    [&](auto&... ops_args)
+                    {
+                        return select_clear_wait(self.success_token_, self.ops_wait_states_, ops_args...);
+                    },
+                    self.ops_);
+            }();
+
+            assert(result.has_value());
+
+            // Free the operation memory before invoking the handler.
+            auto handler = std::move(self.handler_);
+            auto const work_executor = std::move(self.work_executor_);
+            auto allocator = allocator_type{asio::get_associated_allocator(handler, frame_pool_allocator<void>{})};
+            std::destroy_at(&self);
+            allocator_traits::deallocate(allocator, &self, 1);
+
+            Completion{}(std::move(handler), std::move(*result));
+        }
+    };
+
+    template <typename Completion, typename Handler, typename Keepalive, typename MakeOps>
+    void start_async_select(Handler&& handler, Keepalive keepalive, MakeOps make_ops)
+    {
+        using ops_tuple_type = std::invoke_result_t<MakeOps, Keepalive&>;
+        using operation_type = async_select_operation<
+            std::decay_t<Handler>,
+            Completion,
+            Keepalive,
+            ops_tuple_type>;
+
+        operation_type::start(
+            std::forward<Handler>(handler),
+            std::move(keepalive),
+            std::move(make_ops));
+    }
+}  // namespace asiochan::detail
@@ -4,8 +4,11 @@
 #include <cassert>
 #include <cstddef>
 #include <exception>
+#include <memory>
+#include <new>
 #include <queue>
 #include <type_traits>
+#include <utility>
 
 #include "asiochan/channel_buff_size.hpp"
 #include "asiochan/detail/send_slot.hpp"
@@ -13,10 +16,27 @@
 
 namespace asiochan::detail
 {
+    // A ring of raw storage, where the slots in [head, head + count) hold values.
     template <sendable T, channel_buff_size size>
     class channel_buffer
     {
       public:
+        channel_buffer() noexcept = default;
+
+        channel_buffer(channel_buffer const&) = delete;
+        auto operator=(channel_buffer const&) -> channel_buffer& = delete;
+
+        ~channel_buffer() noexcept
+        {
+            if constexpr (not std::is_trivially_destructible_v<T>)
+            {
+                while (not empty())
+                {
+                    pop();
+                }
+            }
+        }
+
         [[nodiscard]] auto empty() const noexcept -> bool
         {
             return count_ == 0;
@@ -27,23 +47,61 @@ namespace asiochan::detail
             return count_ == size;
         }
 
+        [[nodiscard]] auto count() const noexcept -> std::size_t
+        {
+            return count_;
+        }
+
         void enqueue(send_slot<T>& from) noexcept
         {
             assert(not full());
-            transfer(from, buff_[(head_ + count_++) % size]);
+            from.move_to(storage_at((head_ + count_++) % size));
         }
 
         void dequeue(send_slot<T>& to) noexcept
         {
             assert(not empty());
             --count_;
-            transfer(buff_[std::exchange(head_, (head_ + 1) % size)], to);
+            to.move_from(slot(std::exchange(head_, (head_ + 1) % size)));
+        }
+
+        template <typename... Args>
+        void emplace(Args&&... args)
+        {
+            assert(not full());
+            std::construct_at(storage_at((head_ + count_) % size), std::forward<Args>(args)...);
+            ++count_;
+        }
+
+        [[nodiscard]] auto front() noexcept -> T&
+        {
+            assert(not empty());
+            return *slot(head_);
+        }
+
+        void pop() noexcept
+        {
+            assert(not empty());
+            --count_;
+            std::destroy_at(slot(std::exchange(head_, (head_ + 1) % size)));
         }
 
       private:
         std::size_t head_ = 0;
         std::size_t count_ = 0;
-        std::array<send_slot<T>, size> buff_;
+        alignas(T) std::byte storage_[sizeof(T) * size];
+
+        // The storage of a slot that holds no value yet, to construct one in.
+        [[nodiscard]] auto storage_at(std::size_t const index) noexcept -> T*
+        {
+            return reinterpret_cast<T*>(storage_ + index * sizeof(T));
+        }
+
+        // A slot that holds a value.
+        [[nodiscard]] auto slot(std::size_t const index) noexcept -> T*
+        {
+            return std::launder(storage_at(index));
+        }
     };
 
     // clang-format off
@@ -70,6 +128,11 @@ namespace asiochan::detail
             }
         }
 
+        [[nodiscard]] auto count() const noexcept -> std::size_t
+        {
+            return count_;
+        }
+
         void enqueue(send_slot<void>& from) noexcept
         {
             assert(not full());
@@ -100,6 +163,11 @@ namespace asiochan::detail
             return true;
         }
 
+        [[nodiscard]] static auto count() noexcept -> std::size_t
+        {
+            return 0;
+        }
+
         [[noreturn]] void enqueue(send_slot<void>& from) noexcept
         {
             std::terminate();
@@ -128,6 +196,11 @@ namespace asiochan::detail
             return false;
         }
 
+        [[nodiscard]] auto count() const noexcept -> std::size_t
+        {
+            return queue_.size();
+        }
+
         void enqueue(send_slot<T>& from)
         {
             queue_.push(from.read());
@@ -140,6 +213,24 @@ namespace asiochan::detail
             queue_.pop();
         }
 
+        template <typename... Args>
+        void emplace(Args&&... args)
+        {
+            queue_.emplace(std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] auto front() noexcept -> T&
+        {
+            assert(not empty());
+            return queue_.front();
+        }
+
+        void pop() noexcept
+        {
+            assert(not empty());
+            queue_.pop();
+        }
+
       private:
         std::queue<T> queue_;
     };
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <cassert>
+#include <concepts>
+#include <functional>
 #include <optional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
+#include "asiochan/adaptive_spin.hpp"
 #include "asiochan/asio.hpp"
 #include "asiochan/channel_buff_size.hpp"
 #include "asiochan/channel_concepts.hpp"
+#include "asiochan/channel_loan.hpp"
+#include "asiochan/detail/async_select_operation.hpp"
+#include "asiochan/detail/in_place_ops.hpp"
 #include "asiochan/nothing_op.hpp"
 #include "asiochan/read_op.hpp"
 #include "asiochan/select.hpp"
@@ -57,18 +66,61 @@ namespace asiochan::detail
         requires (static_cast<bool>(flags & readable))
         // clang-format on
         {
-            auto result = co_await select(ops::read(derived()));
+            return select_transformed<T, Executor>(
+                [](auto&& result)
+                {
+                    return std::move(result).template get_received<T>();
+                },
+                ops::read(derived()));
+        }
+
+        // clang-format off
+        [[nodiscard]] auto read(adaptive_spin& spin) -> asio::awaitable<T, Executor>
+        requires (static_cast<bool>(flags & readable))
+        // clang-format on
+        {
+            auto result = co_await select(spin, ops::read(derived()));
 
             co_return std::move(result).template get_received<T>();
         }
 
+        // clang-format off
+        [[nodiscard]] auto blocking_read() -> T
+        requires (static_cast<bool>(flags & readable))
+        // clang-format on
+        {
+            auto result = blocking_select(ops::read(derived()));
+
+            return std::move(result).template get_received<T>();
+        }
+
         // clang-format off
         [[nodiscard]] auto write(T value) -> asio::awaitable<void, Executor>
         requires (static_cast<bool>(flags & writable))
                  and (buff_size != unbounded_channel_buff)
         // clang-format on
         {
-            co_await select(ops::write(std::move(value), derived()));
+            return select_transformed<void, Executor>(
+                [](auto&&) {},
+                ops::write(std::move(value), derived()));
+        }
+
+        // clang-format off
+        [[nodiscard]] auto write(T value, adaptive_spin& spin) -> asio::awaitable<void, Executor>
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size != unbounded_channel_buff)
+        // clang-format on
+        {
+            co_await select(spin, ops::write(std::move(value), derived()));
+        }
+
+        // clang-format off
+        void blocking_write(T value)
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size != unbounded_channel_buff)
+        // clang-format on
+        {
+            static_cast<void>(blocking_select(ops::write(std::move(value), derived())));
         }
 
         // clang-format off
@@ -80,6 +132,245 @@ namespace asiochan::detail
             select_ready(ops::write(std::move(value), derived()));
         }
 
+        // clang-format off
+        template <typename... Args>
+        requires (static_cast<bool>(flags & writable))
+                 and std::constructible_from<T, Args&&...>
+                 and (buff_size != 0 or std::is_nothrow_constructible_v<T, Args&&...>)
+        [[nodiscard]] auto try_emplace_write(Args&&... args) -> bool
+        // clang-format on
+        {
+            return detail::try_emplace_write(derived().shared_state(), std::forward<Args>(args)...);
+        }
+
+        // clang-format off
+        template <typename... Args>
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size != unbounded_channel_buff)
+                 and std::constructible_from<T, Args&&...>
+        [[nodiscard]] auto emplace_write(Args... args) -> asio::awaitable<void, Executor>
+        // clang-format on
+        {
+            if constexpr (buff_size != 0 or std::is_nothrow_constructible_v<T, Args&&...>)
+            {
+                if (detail::try_emplace_write(derived().shared_state(), std::move(args)...))
+                {
+                    co_return;
+                }
+            }
+
+            co_await select(ops::write(T(std::move(args)...), derived()));
+        }
+
+        // clang-format off
+        template <typename... Args>
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size == unbounded_channel_buff)
+                 and std::constructible_from<T, Args&&...>
+        void emplace_write(Args&&... args)
+        // clang-format on
+        {
+            [[maybe_unused]] auto const written = detail::try_emplace_write(
+                derived().shared_state(),
+                std::forward<Args>(args)...);
+            assert(written);
+        }
+
+        // On buffered channels without loans, the callback runs with the channel locked:
+        // it must not use this channel, and blocks all of its readers and writers while it runs.
+        // clang-format off
+        template <std::invocable<T&> Callback>
+        requires (static_cast<bool>(flags & readable))
+        [[nodiscard]] auto try_read_with(Callback&& callback) -> bool
+        // clang-format on
+        {
+            if constexpr (Derived::shared_state_type::loans)
+            {
+                // The slot is pinned by a read loan, so the callback runs with the channel unlocked.
+                auto loan = try_acquire();
+                if (not loan)
+                {
+                    return false;
+                }
+
+                derived().shared_state().stats().record_waitfree(channel_op_kind::read);
+                std::invoke(callback, loan->get());
+
+                return true;
+            }
+            else
+            {
+                return detail::try_read_with(derived().shared_state(), callback);
+            }
+        }
+
+        // clang-format off
+        template <std::invocable<T&> Callback>
+        requires (static_cast<bool>(flags & readable))
+        [[nodiscard]] auto read_with(Callback callback) -> asio::awaitable<void, Executor>
+        // clang-format on
+        {
+            if (try_read_with(callback))
+            {
+                co_return;
+            }
+
+            auto result = co_await select(ops::read(derived()));
+            std::invoke(callback, result.template get_received<T>());
+        }
+
+        // The callback runs with the channel locked: it must not use this channel,
+        // and blocks all of its readers and writers while it runs.
+        // clang-format off
+        template <std::invocable<T const&> Callback>
+        requires (static_cast<bool>(flags & readable))
+                 and (buff_size != 0)
+        [[nodiscard]] auto try_peek(Callback&& callback) -> bool
+        // clang-format on
+        {
+            return detail::try_peek(derived().shared_state(), callback);
+        }
+
+        // clang-format off
+        [[nodiscard]] auto try_reserve() -> std::optional<write_loan<Derived>>
+        requires (static_cast<bool>(flags & writable))
+                 and Derived::shared_state_type::loans
+                 and std::default_initializable<T>
+        // clang-format on
+        {
+            auto& channel_state = derived().shared_state();
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            if (channel_state.buffer().full())
+            {
+                return std::nullopt;
+            }
+
+            auto const index = channel_state.buffer().reserve();
+            channel_state.stats().record_buffer_size(channel_state.buffer().count());
+
+            return write_loan<Derived>{derived(), index};
+        }
+
+        // clang-format off
+        [[nodiscard]] auto reserve() -> asio::awaitable<write_loan<Derived>, Executor>
+        requires (static_cast<bool>(flags & writable))
+                 and Derived::shared_state_type::loans
+                 and std::default_initializable<T>
+        // clang-format on
+        {
+            while (true)
+            {
+                if (auto loan = try_reserve())
+                {
+                    co_return std::move(*loan);
+                }
+
+                // Woken whenever the buffer changes, so retry until successful.
+                auto& channel_state = derived().shared_state();
+                auto waiter_node = channel_waiter_list_node<T, Executor>{};
+                co_await wait_in_list<Executor>(
+                    channel_state.mutex(),
+                    channel_state.buffer().space_waiters(),
+                    waiter_node,
+                    [&]()
+                    {
+                        return not channel_state.buffer().full();
+                    });
+            }
+        }
+
+        // clang-format off
+        [[nodiscard]] auto try_acquire() -> std::optional<read_loan<Derived>>
+        requires (static_cast<bool>(flags & readable))
+                 and Derived::shared_state_type::loans
+        // clang-format on
+        {
+            auto& channel_state = derived().shared_state();
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            if (channel_state.buffer().empty())
+            {
+                return std::nullopt;
+            }
+
+            auto const index = channel_state.buffer().acquire();
+            channel_state.trace_read_dequeued();
+
+            return read_loan<Derived>{derived(), index};
+        }
+
+        // clang-format off
+        [[nodiscard]] auto acquire() -> asio::awaitable<read_loan<Derived>, Executor>
+        requires (static_cast<bool>(flags & readable))
+                 and Derived::shared_state_type::loans
+        // clang-format on
+        {
+            while (true)
+            {
+                if (auto loan = try_acquire())
+                {
+                    co_return std::move(*loan);
+                }
+
+                // Woken whenever the buffer changes, so retry until successful.
+                auto& channel_state = derived().shared_state();
+                auto waiter_node = channel_waiter_list_node<T, Executor>{};
+                co_await wait_in_list<Executor>(
+                    channel_state.mutex(),
+                    channel_state.buffer().value_waiters(),
+                    waiter_node,
+                    [&]()
+                    {
+                        return not channel_state.buffer().empty();
+                    });
+            }
+        }
+
+        // clang-format off
+        template <typename CompletionToken>
+        requires (static_cast<bool>(flags & readable))
+        auto async_read(CompletionToken&& token)
+        // clang-format on
+        {
+            return asio::async_initiate<CompletionToken, void(T)>(
+                [](auto&& handler, Derived channel)
+                {
+                    start_async_select<read_completion<T>>(
+                        std::forward<decltype(handler)>(handler),
+                        std::move(channel),
+                        [](Derived& channel)
+                        {
+                            return std::tuple{ops::read(channel)};
+                        });
+                },
+                token,
+                derived());
+        }
+
+        // clang-format off
+        template <typename CompletionToken>
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size != unbounded_channel_buff)
+        auto async_write(T value, CompletionToken&& token)
+        // clang-format on
+        {
+            return asio::async_initiate<CompletionToken, void()>(
+                [](auto&& handler, Derived channel, T value)
+                {
+                    start_async_select<write_completion>(
+                        std::forward<decltype(handler)>(handler),
+                        std::move(channel),
+                        [&](Derived& channel)
+                        {
+                            return std::tuple{ops::write(std::move(value), channel)};
+                        });
+                },
+                token,
+                derived(),
+                std::move(value));
+        }
+
       private:
         [[nodiscard]] auto derived() noexcept -> Derived&
         {
@@ -124,7 +415,25 @@ namespace asiochan::detail
         requires (static_cast<bool>(flags & readable))
         // clang-format on
         {
-            co_await select(ops::read(derived()));
+            return select_transformed<void, Executor>(
+                [](auto&&) {},
+                ops::read(derived()));
+        }
+
+        // clang-format off
+        [[nodiscard]] auto read(adaptive_spin& spin) -> asio::awaitable<void>
+        requires (static_cast<bool>(flags & readable))
+        // clang-format on
+        {
+            co_await select(spin, ops::read(derived()));
+        }
+
+        // clang-format off
+        void blocking_read()
+        requires (static_cast<bool>(flags & readable))
+        // clang-format on
+        {
+            static_cast<void>(blocking_select(ops::read(derived())));
         }
 
         // clang-format off
@@ -133,7 +442,27 @@ namespace asiochan::detail
                  and (buff_size != unbounded_channel_buff)
         // clang-format on
         {
-            co_await select(ops::write(derived()));
+            return select_transformed<void, Executor>(
+                [](auto&&) {},
+                ops::write(derived()));
+        }
+
+        // clang-format off
+        [[nodiscard]] auto write(adaptive_spin& spin) -> asio::awaitable<void>
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size != unbounded_channel_buff)
+        // clang-format on
+        {
+            co_await select(spin, ops::write(derived()));
+        }
+
+        // clang-format off
+        void blocking_write()
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size != unbounded_channel_buff)
+        // clang-format on
+        {
+            static_cast<void>(blocking_select(ops::write(derived())));
         }
 
         // clang-format off
@@ -145,6 +474,49 @@ namespace asiochan::detail
             select_ready(ops::write(derived()));
         }
 
+        // clang-format off
+        template <typename CompletionToken>
+        requires (static_cast<bool>(flags & readable))
+        auto async_read(CompletionToken&& token)
+        // clang-format on
+        {
+            return asio::async_initiate<CompletionToken, void()>(
+                [](auto&& handler, Derived channel)
+                {
+                    start_async_select<read_completion<void>>(
+                        std::forward<decltype(handler)>(handler),
+                        std::move(channel),
+                        [](Derived& channel)
+                        {
+                            return std::tuple{ops::read(channel)};
+                        });
+                },
+                token,
+                derived());
+        }
+
+        // clang-format off
+        template <typename CompletionToken>
+        requires (static_cast<bool>(flags & writable))
+                 and (buff_size != unbounded_channel_buff)
+        auto async_write(CompletionToken&& token)
+        // clang-format on
+        {
+            return asio::async_initiate<CompletionToken, void()>(
+                [](auto&& handler, Derived channel)
+                {
+                    start_async_select<write_completion>(
+                        std::forward<decltype(handler)>(handler),
+                        std::move(channel),
+                        [](Derived& channel)
+                        {
+                            return std::tuple{ops::write(channel)};
+                        });
+                },
+                token,
+                derived());
+        }
+
       private:
         [[nodiscard]] auto derived() noexcept -> Derived&
         {
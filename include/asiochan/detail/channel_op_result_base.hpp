@@ -12,6 +12,10 @@ namespace asiochan::detail
         explicit channel_op_result_base(channel_type<T> auto& channel)
           : shared_state_{&channel.shared_state()} { }
 
+        // For results of type-erased channel operations.
+        explicit channel_op_result_base(void* const shared_state) noexcept
+          : shared_state_{shared_state} { }
+
         [[nodiscard]] static auto matches(any_channel_type auto const&) noexcept -> bool
         {
             return false;
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <mutex>
+#include <string>
 #include <type_traits>
 
 #include "asiochan/asio.hpp"
 #include "asiochan/channel_buff_size.hpp"
+#include "asiochan/channel_policy.hpp"
+#include "asiochan/channel_registry.hpp"
+#include "asiochan/channel_stats.hpp"
 #include "asiochan/detail/channel_buffer.hpp"
 #include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/loan_channel_buffer.hpp"
 #include "asiochan/detail/send_slot.hpp"
 #include "asiochan/sendable.hpp"
 
@@ -38,16 +45,55 @@ namespace asiochan::detail
         static constexpr bool write_never_waits = true;
     };
 
-    template <sendable T, asio::execution::executor Executor, channel_buff_size buff_size_>
+    template <sendable T,
+              asio::execution::executor Executor,
+              channel_buff_size buff_size_,
+              typename Policy = default_channel_policy>
     class channel_shared_state
       : public channel_shared_state_writer_list_base<T, Executor, buff_size_ != unbounded_channel_buff>
     {
       public:
-        using mutex_type = std::mutex;
-        using buffer_type = channel_buffer<T, buff_size_>;
+        using send_type = T;
+        using mutex_type = typename channel_policy_traits<Policy>::mutex_type;
+        static constexpr bool loans = channel_policy_traits<Policy>::loans
+                                      and not std::is_void_v<T>
+                                      and buff_size_ != 0
+                                      and buff_size_ != unbounded_channel_buff;
+
+        using buffer_type = std::conditional_t<
+            loans,
+            loan_channel_buffer<T, buff_size_, Executor>,
+            channel_buffer<T, buff_size_>>;
         using reader_list_type = channel_waiter_list<T, Executor>;
+        using policy_type = Policy;
+        using stats_type = typename channel_policy_traits<Policy>::stats_type;
+        using tracer_type = typename channel_policy_traits<Policy>::tracer_type;
 
         static constexpr auto buff_size = buff_size_;
+        static constexpr bool stats_enabled = stats_type::enabled;
+        static constexpr bool lock_profiled = requires(mutex_type const& mutex) { mutex.profile(); };
+        static constexpr bool has_stats = stats_enabled or lock_profiled;
+        static constexpr bool registered = channel_policy_traits<Policy>::registered;
+        static constexpr bool tracing_enabled = tracer_type::enabled;
+        static constexpr bool single_threaded = channel_policy_traits<Policy>::single_threaded;
+        static constexpr bool batch_wakeups = channel_policy_traits<Policy>::batch_wakeups;
+        // Parked waiters are stamped only when the channel reports or traces them.
+        static constexpr bool stamps_waiters = registered or tracing_enabled;
+
+        using waiter_node_type = channel_waiter_node_t<T, Executor, stamps_waiters>;
+
+        channel_shared_state() = default;
+
+        // clang-format off
+        explicit channel_shared_state(std::string name)
+        requires registered
+          // clang-format on
+          : registration_{std::move(name), &report_to, this}
+        {
+        }
+
+        channel_shared_state(channel_shared_state const&) = delete;
+        auto operator=(channel_shared_state const&) -> channel_shared_state& = delete;
 
         [[nodiscard]] auto reader_list() noexcept -> reader_list_type&
         {
@@ -64,10 +110,162 @@ namespace asiochan::detail
             return mutex_;
         }
 
+        [[nodiscard]] auto stats() noexcept -> stats_type&
+        {
+            return stats_;
+        }
+
+        [[nodiscard]] auto tracer() noexcept -> tracer_type&
+        {
+            return tracer_;
+        }
+
+        // The trace methods must be called with the mutex held.
+        // They compile to nothing unless the policy enables tracing.
+        void trace_write_enqueued()
+        {
+            if constexpr (tracing_enabled)
+            {
+                tracer_.on_write_enqueued(std::chrono::steady_clock::now());
+            }
+        }
+
+        // The value of a parked writer entered the channel when the writer parked.
+        template <typename WaiterNode>
+        void trace_write_enqueued([[maybe_unused]] WaiterNode const& writer)
+        {
+            if constexpr (tracing_enabled)
+            {
+                tracer_.on_write_enqueued(static_cast<waiter_node_type const&>(writer).parked_at);
+            }
+        }
+
+        // Called after values were stored in the buffer, or a loan changed it.
+        // Buffers with loans deliver values in reservation order rather than in the order they were stored,
+        // so their values are traced once every earlier reservation was committed or abandoned.
+        void trace_buffer_enqueued()
+        {
+            if constexpr (tracing_enabled and loans)
+            {
+                auto const now = std::chrono::steady_clock::now();
+                for (auto num_published = buffer_.publish(); num_published != 0; --num_published)
+                {
+                    tracer_.on_write_enqueued(now);
+                }
+            }
+            else
+            {
+                trace_write_enqueued();
+            }
+        }
+
+        template <typename WaiterNode>
+        void trace_buffer_enqueued([[maybe_unused]] WaiterNode const& writer)
+        {
+            if constexpr (loans)
+            {
+                trace_buffer_enqueued();
+            }
+            else
+            {
+                trace_write_enqueued(writer);
+            }
+        }
+
+        void trace_read_dequeued()
+        {
+            if constexpr (tracing_enabled)
+            {
+                tracer_.on_read_dequeued(std::chrono::steady_clock::now());
+            }
+        }
+
+        template <typename WaiterNode>
+        void trace_waiter_parked([[maybe_unused]] channel_op_kind const op, [[maybe_unused]] WaiterNode const& waiter)
+        {
+            if constexpr (tracing_enabled)
+            {
+                tracer_.on_waiter_parked(op, static_cast<waiter_node_type const&>(waiter).parked_at);
+            }
+        }
+
+        void trace_waiter_woken([[maybe_unused]] channel_op_kind const op)
+        {
+            if constexpr (tracing_enabled)
+            {
+                tracer_.on_waiter_woken(op, std::chrono::steady_clock::now());
+            }
+        }
+
+        // clang-format off
+        [[nodiscard]] auto stats_snapshot() -> channel_stats_snapshot
+        requires has_stats
+        // clang-format on
+        {
+            auto snapshot = channel_stats_snapshot{};
+            if constexpr (stats_enabled)
+            {
+                stats_.load(snapshot);
+            }
+            if constexpr (lock_profiled)
+            {
+                snapshot.lock = mutex_.profile().snapshot();
+            }
+
+            auto const lock = std::scoped_lock{mutex_};
+            snapshot.buffer_size = buffer_.count();
+            snapshot.reads.parked = reader_list_.size();
+            if constexpr (not channel_shared_state::write_never_waits)
+            {
+                snapshot.writes.parked = this->writer_list().size();
+            }
+
+            return snapshot;
+        }
+
       private:
         mutex_type mutex_;
         reader_list_type reader_list_;
         [[no_unique_address]] buffer_type buffer_;
+        [[no_unique_address]] stats_type stats_;
+        [[no_unique_address]] tracer_type tracer_;
+        // Declared last, so that the channel is unregistered before any other member is destroyed.
+        [[no_unique_address]] channel_registration<registered> registration_{std::string{}, &report_to, this};
+
+        static void report_to(void* const owner, channel_report& report)
+        {
+            auto& self = *static_cast<channel_shared_state*>(owner);
+            auto const now = std::chrono::steady_clock::now();
+            auto const lock = std::scoped_lock{self.mutex_};
+
+            report.buffer_size = self.buffer_.count();
+            if constexpr (buff_size != unbounded_channel_buff)
+            {
+                report.buffer_capacity = buff_size;
+            }
+
+            auto const add_oldest = [&]([[maybe_unused]] auto const& waiter_list)
+            {
+                // Only registered channels are reported, and they stamp their waiters.
+                if constexpr (stamps_waiters)
+                {
+                    if (auto const oldest = static_cast<waiter_node_type const*>(waiter_list.front()))
+                    {
+                        auto const age = now - oldest->parked_at;
+                        report.oldest_waiter_age = std::max(report.oldest_waiter_age.value_or(age), age);
+                    }
+                }
+            };
+
+            report.parked_readers = self.reader_list_.size();
+            add_oldest(self.reader_list_);
+
+            if constexpr (not channel_shared_state::write_never_waits)
+            {
+                report.parked_writers = self.writer_list().size();
+                add_oldest(self.writer_list());
+            }
+        }
     };
 
     template <typename T, sendable SendType, asio::execution::executor Executor>
@@ -78,9 +276,10 @@ namespace asiochan::detail
 
     template <sendable SendType,
               asio::execution::executor Executor,
-              channel_buff_size buff_size>
+              channel_buff_size buff_size,
+              typename Policy>
     struct is_channel_shared_state<
-        channel_shared_state<SendType, Executor, buff_size>,
+        channel_shared_state<SendType, Executor, buff_size, Policy>,
         SendType,
         Executor>
       : std::true_type
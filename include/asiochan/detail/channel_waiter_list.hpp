@@ -1,23 +1,152 @@
 #pragma once
 
+#include <cassert>
+#include <chrono>
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
 #include <mutex>
+#include <optional>
+#include <type_traits>
 
 #include "asiochan/async_promise.hpp"
 #include "asiochan/detail/send_slot.hpp"
+#include "asiochan/lock_profile.hpp"
 #include "asiochan/sendable.hpp"
 
 namespace asiochan::detail
 {
     using select_waiter_token = std::size_t;
 
+#ifdef ASIOCHAN_PROFILE_SELECT_LOCKS
+    using select_wait_mutex = select_profiled_mutex;
+    using select_wait_condition_variable = std::condition_variable_any;
+#else
+    using select_wait_mutex = std::mutex;
+    using select_wait_condition_variable = std::condition_variable;
+#endif
+
+    // The mutex of a wait context, which does nothing once elided.
+    class select_wait_context_mutex
+    {
+      public:
+        // Only for contexts that are claimed and completed from the executor of the waiter.
+        void elide() noexcept
+        {
+            elided_ = true;
+        }
+
+        void lock()
+        {
+            if (not elided_)
+            {
+                mutex_.lock();
+            }
+        }
+
+        [[nodiscard]] auto try_lock() -> bool
+        {
+            return elided_ or mutex_.try_lock();
+        }
+
+        void unlock()
+        {
+            if (not elided_)
+            {
+                mutex_.unlock();
+            }
+        }
+
+        [[nodiscard]] auto native() noexcept -> select_wait_mutex&
+        {
+            return mutex_;
+        }
+
+      private:
+        select_wait_mutex mutex_;
+        bool elided_ = false;
+    };
+
     template <asio::execution::executor Executor>
     struct select_wait_context
     {
-        async_promise<select_waiter_token, Executor> promise;
-        std::mutex mutex;
+        using complete_fn = void (*)(select_wait_context& ctx, select_waiter_token token);
+
+        complete_fn on_complete = nullptr;
+        select_wait_context_mutex mutex;
         bool avail_flag = true;
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+        asio::cancellation_slot cancellation_slot;
+#endif
+    };
+
+    template <asio::execution::executor Executor, bool executor_affine = false>
+    struct select_promise_wait_context : select_wait_context<Executor>
+    {
+        async_promise<select_waiter_token, Executor> promise;
+
+        select_promise_wait_context() noexcept
+        {
+            this->on_complete = &set_promise_value;
+            if constexpr (executor_affine)
+            {
+                this->mutex.elide();
+            }
+        }
+
+        static void set_promise_value(
+            select_wait_context<Executor>& ctx,
+            select_waiter_token const token)
+        {
+            auto& self = static_cast<select_promise_wait_context&>(ctx);
+            if constexpr (executor_affine)
+            {
+                // Only completed from the executor of the waiter, resume it as a continuation.
+                self.promise.defer_value(token);
+            }
+            else
+            {
+                self.promise.set_value(token);
+            }
+        }
+    };
+
+    template <asio::execution::executor Executor>
+    struct select_blocking_wait_context : select_wait_context<Executor>
+    {
+        select_wait_condition_variable cond;
+        std::optional<select_waiter_token> completed_token = std::nullopt;
+
+        select_blocking_wait_context() noexcept
+        {
+            this->on_complete = &notify_thread;
+        }
+
+        [[nodiscard]] auto wait() -> select_waiter_token
+        {
+            auto lock = std::unique_lock{this->mutex.native()};
+            cond.wait(
+                lock,
+                [&]()
+                {
+                    return completed_token.has_value();
+                });
+
+            return *completed_token;
+        }
+
+        static void notify_thread(
+            select_wait_context<Executor>& ctx,
+            select_waiter_token const token)
+        {
+            auto& self = static_cast<select_blocking_wait_context&>(ctx);
+
+            // Notify while holding the lock, so that the waiting thread
+            // cannot destroy the context before we are done with it.
+            auto const lock = std::scoped_lock{self.mutex};
+            self.completed_token = token;
+            self.cond.notify_one();
+        }
     };
 
     template <asio::execution::executor Executor>
@@ -27,6 +156,13 @@ namespace asiochan::detail
         return std::exchange(ctx.avail_flag, false);
     }
 
+    template <asio::execution::executor Executor>
+    void complete(select_wait_context<Executor>& ctx, select_waiter_token const token)
+    {
+        assert(ctx.on_complete);
+        ctx.on_complete(ctx, token);
+    }
+
     template <sendable T, asio::execution::executor Executor>
     struct channel_waiter_list_node
     {
@@ -37,12 +173,34 @@ namespace asiochan::detail
         channel_waiter_list_node* next = nullptr;
     };
 
+    // A waiter node that also records when it parked.
+    // Only registered or traced channels read the stamp, so other channels park the smaller plain node.
+    template <sendable T, asio::execution::executor Executor>
+    struct channel_stamped_waiter_list_node : channel_waiter_list_node<T, Executor>
+    {
+        std::chrono::steady_clock::time_point parked_at = {};
+    };
+
+    template <sendable T, asio::execution::executor Executor, bool stamped>
+    using channel_waiter_node_t = std::conditional_t<stamped,
+                                                     channel_stamped_waiter_list_node<T, Executor>,
+                                                     channel_waiter_list_node<T, Executor>>;
+
     template <sendable T, asio::execution::executor Executor>
     void notify_waiter(channel_waiter_list_node<T, Executor>& waiter)
     {
-        waiter.ctx->promise.set_value(waiter.token);
+        complete(*waiter.ctx, waiter.token);
     }
 
+    // The outcome of submitting one alternative of a waiting select.
+    enum class channel_submit_result
+    {
+        ready,
+        waiting,
+        // A different alternative of the select completed concurrently.
+        claimed_elsewhere,
+    };
+
     template <sendable T, asio::execution::executor Executor>
     class channel_waiter_list
     {
@@ -79,13 +237,13 @@ namespace asiochan::detail
             if (node.prev)
             {
                 node.prev->next = node.next;
-                node.prev = nullptr;
             }
             if (node.next)
             {
                 node.next->prev = node.prev;
-                node.next = nullptr;
             }
+            node.prev = nullptr;
+            node.next = nullptr;
         }
 
         auto dequeue_first_available(
@@ -132,8 +290,53 @@ namespace asiochan::detail
             return nullptr;
         }
 
+        [[nodiscard]] auto front() const noexcept -> node_type const*
+        {
+            return first_;
+        }
+
+        // Linear in the number of waiters, meant for diagnostics only.
+        [[nodiscard]] auto size() const noexcept -> std::size_t
+        {
+            auto count = std::size_t{0};
+            for (auto node = first_; node; node = node->next)
+            {
+                ++count;
+            }
+
+            return count;
+        }
+
       private:
         node_type* first_ = nullptr;
         node_type* last_ = nullptr;
     };
+
+    // Parks the calling coroutine in the waiter list, unless the predicate is true under the lock.
+    // Whoever dequeues the node from the list resumes the coroutine.
+    template <asio::execution::executor Executor, typename Mutex, sendable T, typename Ready>
+    auto wait_in_list(
+        Mutex& mutex,
+        channel_waiter_list<T, Executor>& waiter_list,
+        channel_waiter_list_node<T, Executor>& waiter_node,
+        Ready ready)
+        -> asio::awaitable<void, Executor>
+    {
+        auto wait_ctx = select_promise_wait_context<Executor>{};
+
+        static_cast<void>(co_await wait_ctx.promise.get_awaitable(
+            [&]()
+            {
+                auto const lock = std::scoped_lock{mutex};
+                if (ready())
+                {
+                    wait_ctx.avail_flag = false;
+                    complete(wait_ctx, 0);
+                    return;
+                }
+
+                waiter_node.ctx = &wait_ctx;
+                waiter_list.enqueue(waiter_node);
+            }));
+    }
 }  // namespace asiochan::detail
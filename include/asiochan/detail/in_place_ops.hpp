@@ -0,0 +1,172 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "asiochan/channel_stats.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+
+namespace asiochan::detail
+{
+    // Constructs a value directly in the slot of a waiting reader, or in the channel buffer.
+    // Returns false, without using the arguments, if neither is available.
+    template <typename ChannelState, typename... Args>
+    [[nodiscard]] auto try_emplace_write(ChannelState& channel_state, Args&&... args) -> bool
+    {
+        using value_type = typename ChannelState::send_type;
+        constexpr auto nothrow = std::is_nothrow_constructible_v<value_type, Args&&...>;
+
+        auto const lock = std::scoped_lock{channel_state.mutex()};
+
+        if constexpr (nothrow)
+        {
+            // A claimed reader must be woken, so only construct in its slot if that cannot fail.
+            if (auto const reader = channel_state.reader_list().dequeue_first_available())
+            {
+                reader->slot->emplace(std::forward<Args>(args)...);
+                channel_state.trace_write_enqueued();
+                channel_state.trace_read_dequeued();
+                channel_state.trace_waiter_woken(channel_op_kind::read);
+                notify_waiter(*reader);
+                channel_state.stats().record_waitfree(channel_op_kind::write);
+
+                return true;
+            }
+        }
+
+        if constexpr (ChannelState::buff_size != 0)
+        {
+            if (not channel_state.buffer().full())
+            {
+                channel_state.buffer().emplace(std::forward<Args>(args)...);
+                channel_state.trace_buffer_enqueued();
+                channel_state.stats().record_waitfree(channel_op_kind::write);
+
+                if constexpr (not nothrow)
+                {
+                    if (auto const reader = channel_state.reader_list().dequeue_first_available())
+                    {
+                        // Buffer was empty with readers waiting.
+                        channel_state.buffer().dequeue(*reader->slot);
+                        channel_state.trace_read_dequeued();
+                        channel_state.trace_waiter_woken(channel_op_kind::read);
+                        notify_waiter(*reader);
+                    }
+                }
+
+                channel_state.stats().record_buffer_size(channel_state.buffer().count());
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Invokes the callback with the next value, in place in the buffer or in the slot of a waiting writer.
+    // The value is released afterwards, even if the callback throws.
+    // The slot of a waiting writer is claimed and the channel unlocked before invoking the callback.
+    // A buffered value is only pinned by the channel mutex, so the callback is invoked with the channel locked:
+    // it must not access the channel, and blocks all other operations of the channel while it runs.
+    template <typename ChannelState, typename Callback>
+    [[nodiscard]] auto try_read_with(ChannelState& channel_state, Callback& callback) -> bool
+    {
+        auto lock = std::unique_lock{channel_state.mutex()};
+
+        if constexpr (ChannelState::buff_size != 0)
+        {
+            if (not channel_state.buffer().empty())
+            {
+                auto const release = [&]()
+                {
+                    channel_state.buffer().pop();
+                    channel_state.trace_read_dequeued();
+                    channel_state.stats().record_waitfree(channel_op_kind::read);
+
+                    if constexpr (not ChannelState::write_never_waits)
+                    {
+                        // Slots held by read loans are only freed once released.
+                        auto const writer = channel_state.buffer().full()
+                                                ? nullptr
+                                                : channel_state.writer_list().dequeue_first_available();
+                        if (writer)
+                        {
+                            // Buffer was full with writers waiting.
+                            // Wake the oldest writer and store his value in the buffer.
+                            channel_state.buffer().enqueue(*writer->slot);
+                            channel_state.trace_buffer_enqueued(*writer);
+                            channel_state.trace_waiter_woken(channel_op_kind::write);
+                            notify_waiter(*writer);
+                        }
+                    }
+                };
+
+                try
+                {
+                    std::invoke(callback, channel_state.buffer().front());
+                }
+                catch (...)
+                {
+                    release();
+                    throw;
+                }
+
+                release();
+
+                return true;
+            }
+        }
+        else if (auto const writer = channel_state.writer_list().dequeue_first_available())
+        {
+            // The writer stays parked until it is notified, so its slot can be read without the lock.
+            lock.unlock();
+
+            auto const release = [&]()
+            {
+                lock.lock();
+                writer->slot->reset();
+                channel_state.trace_write_enqueued(*writer);
+                channel_state.trace_read_dequeued();
+                channel_state.trace_waiter_woken(channel_op_kind::write);
+                notify_waiter(*writer);
+                channel_state.stats().record_waitfree(channel_op_kind::read);
+            };
+
+            try
+            {
+                std::invoke(callback, writer->slot->get());
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+
+            release();
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Invokes the callback with the oldest buffered value, without removing it.
+    // The callback is invoked with the channel locked: it must not access the channel,
+    // and blocks all other operations of the channel while it runs.
+    template <typename ChannelState, typename Callback>
+    [[nodiscard]] auto try_peek(ChannelState& channel_state, Callback& callback) -> bool
+    {
+        auto const lock = std::scoped_lock{channel_state.mutex()};
+
+        if (channel_state.buffer().empty())
+        {
+            return false;
+        }
+
+        std::invoke(callback, std::as_const(channel_state.buffer().front()));
+
+        return true;
+    }
+}  // namespace asiochan::detail
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/channel_buff_size.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/send_slot.hpp"
+#include "asiochan/sendable.hpp"
+
+namespace asiochan::detail
+{
+    enum class loan_slot_state : std::uint8_t
+    {
+        free,
+        reserved,
+        committed,
+        acquired,
+        released,
+    };
+
+    // A bounded buffer whose slots can be lent to writers before they are filled,
+    // and to readers before they are emptied. Slots are delivered in the order they were reserved,
+    // and become free in the same order, once every earlier slot was released.
+    template <sendable T, channel_buff_size size, asio::execution::executor Executor>
+    class loan_channel_buffer
+    {
+      public:
+        using waiter_list_type = channel_waiter_list<T, Executor>;
+
+        [[nodiscard]] auto empty() const noexcept -> bool
+        {
+            return num_read_ == count_ or states_[read_index()] != loan_slot_state::committed;
+        }
+
+        [[nodiscard]] auto full() const noexcept -> bool
+        {
+            return count_ == size;
+        }
+
+        [[nodiscard]] auto count() const noexcept -> std::size_t
+        {
+            return count_;
+        }
+
+        void enqueue(send_slot<T>& from) noexcept
+        {
+            assert(not full());
+            auto const index = tail_index();
+            transfer(from, slots_[index]);
+            states_[index] = loan_slot_state::committed;
+            ++count_;
+            wake_one(value_waiters_);
+        }
+
+        void dequeue(send_slot<T>& to) noexcept
+        {
+            assert(not empty());
+            auto const index = read_index();
+            transfer(slots_[index], to);
+            states_[index] = loan_slot_state::released;
+            settle();
+        }
+
+        template <typename... Args>
+        void emplace(Args&&... args)
+        {
+            assert(not full());
+            auto const index = tail_index();
+            slots_[index].emplace(std::forward<Args>(args)...);
+            states_[index] = loan_slot_state::committed;
+            ++count_;
+            wake_one(value_waiters_);
+        }
+
+        [[nodiscard]] auto front() noexcept -> T&
+        {
+            assert(not empty());
+            return slots_[read_index()].get();
+        }
+
+        void pop() noexcept
+        {
+            assert(not empty());
+            auto const index = read_index();
+            slots_[index].reset();
+            states_[index] = loan_slot_state::released;
+            settle();
+        }
+
+        template <typename... Args>
+        [[nodiscard]] auto reserve(Args&&... args) -> std::size_t
+        {
+            assert(not full());
+            auto const index = tail_index();
+            slots_[index].emplace(std::forward<Args>(args)...);
+            states_[index] = loan_slot_state::reserved;
+            ++count_;
+
+            return index;
+        }
+
+        void commit(std::size_t const index) noexcept
+        {
+            assert(states_[index] == loan_slot_state::reserved);
+            states_[index] = loan_slot_state::committed;
+            if (not empty())
+            {
+                // Committing the oldest reservation may unblock several later ones.
+                wake_all(value_waiters_);
+            }
+        }
+
+        [[nodiscard]] auto acquire() noexcept -> std::size_t
+        {
+            assert(not empty());
+            auto const index = read_index();
+            states_[index] = loan_slot_state::acquired;
+            ++num_read_;
+            settle();
+
+            return index;
+        }
+
+        // Releases an acquired slot, or abandons a reserved one.
+        void release(std::size_t const index) noexcept
+        {
+            assert(states_[index] == loan_slot_state::reserved or states_[index] == loan_slot_state::acquired);
+            slots_[index].reset();
+            states_[index] = loan_slot_state::released;
+            settle();
+        }
+
+        // Marks the slots that are next in delivery order and no longer reserved as published,
+        // and returns the number of committed values among them. Used by tracing,
+        // so that values are traced as enqueued in the order they are delivered.
+        [[nodiscard]] auto publish() noexcept -> std::size_t
+        {
+            auto num_committed = std::size_t{0};
+            while (num_published_ != count_)
+            {
+                auto const state = states_[(head_ + num_published_) % size];
+                if (state == loan_slot_state::reserved)
+                {
+                    break;
+                }
+
+                num_committed += state == loan_slot_state::committed;
+                ++num_published_;
+            }
+
+            return num_committed;
+        }
+
+        [[nodiscard]] auto get(std::size_t const index) noexcept -> T&
+        {
+            return slots_[index].get();
+        }
+
+        [[nodiscard]] auto space_waiters() noexcept -> waiter_list_type&
+        {
+            return space_waiters_;
+        }
+
+        [[nodiscard]] auto value_waiters() noexcept -> waiter_list_type&
+        {
+            return value_waiters_;
+        }
+
+      private:
+        std::size_t head_ = 0;
+        std::size_t count_ = 0;
+        // The number of slots after head that were already read, acquired or abandoned.
+        std::size_t num_read_ = 0;
+        // The number of slots after head that were already published.
+        std::size_t num_published_ = 0;
+        std::array<send_slot<T>, size> slots_;
+        std::array<loan_slot_state, size> states_ = {};
+        waiter_list_type space_waiters_;
+        waiter_list_type value_waiters_;
+
+        [[nodiscard]] auto read_index() const noexcept -> std::size_t
+        {
+            return (head_ + num_read_) % size;
+        }
+
+        [[nodiscard]] auto tail_index() const noexcept -> std::size_t
+        {
+            return (head_ + count_) % size;
+        }
+
+        void settle() noexcept
+        {
+            auto const was_empty = empty();
+            auto num_freed = std::size_t{0};
+            while (true)
+            {
+                // Skip abandoned reservations.
+                while (num_read_ != count_ and states_[read_index()] == loan_slot_state::released)
+                {
+                    ++num_read_;
+                }
+
+                if (count_ == 0 or states_[head_] != loan_slot_state::released)
+                {
+                    break;
+                }
+
+                states_[head_] = loan_slot_state::free;
+                head_ = (head_ + 1) % size;
+                --count_;
+                --num_read_;
+                // An abandoned reservation may be freed before it was published.
+                if (num_published_ != 0)
+                {
+                    --num_published_;
+                }
+                ++num_freed;
+            }
+
+            for (; num_freed != 0; --num_freed)
+            {
+                wake_one(space_waiters_);
+            }
+
+            // Skipping an abandoned reservation may expose committed slots.
+            if (was_empty and not empty())
+            {
+                wake_all(value_waiters_);
+            }
+        }
+
+        static void wake_one(waiter_list_type& waiters) noexcept
+        {
+            if (auto const waiter = waiters.dequeue_first_available())
+            {
+                notify_waiter(*waiter);
+            }
+        }
+
+        static void wake_all(waiter_list_type& waiters) noexcept
+        {
+            while (auto const waiter = waiters.dequeue_first_available())
+            {
+                notify_waiter(*waiter);
+            }
+        }
+    };
+}  // namespace asiochan::detail
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <array>
+#include <concepts>
 #include <cstddef>
+#include <limits>
 #include <optional>
+#include <span>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -10,6 +13,7 @@
 #include "asiochan/asio.hpp"
 #include "asiochan/async_promise.hpp"
 #include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/wakeup_batch_service.hpp"
 #include "asiochan/select_concepts.hpp"
 #include "asiochan/select_result.hpp"
 
@@ -23,4 +27,286 @@ namespace asiochan::detail
             std::exchange(token_base, token_base + Ops::num_alternatives)...,
         };
     }();
+
+    template <select_op Op>
+    inline constexpr bool select_op_executor_affine = false;
+
+    // clang-format off
+    template <select_op Op>
+    requires requires { { Op::executor_affine } -> std::convertible_to<bool>; }
+    inline constexpr bool select_op_executor_affine<Op> = Op::executor_affine;
+    // clang-format on
+
+    // True when all operations complete only from the executor of the selecting coroutine.
+    template <select_op... Ops>
+    inline constexpr bool select_executor_affine = (select_op_executor_affine<Ops> and ...);
+
+    template <select_op Op>
+    inline constexpr bool select_op_batch_wakeups = false;
+
+    // clang-format off
+    template <select_op Op>
+    requires requires { { Op::batch_wakeups } -> std::convertible_to<bool>; }
+    inline constexpr bool select_op_batch_wakeups<Op> = Op::batch_wakeups;
+    // clang-format on
+
+    template <asio::execution::executor Executor, select_op... Ops>
+    using select_promise_wait_context_for = std::conditional_t<
+        select_executor_affine<Ops...>,
+        select_promise_wait_context<Executor, true>,
+        std::conditional_t<
+            (select_op_batch_wakeups<Ops> or ...),
+            select_batched_wait_context<Executor>,
+            select_promise_wait_context<Executor>>>;
+
+    inline constexpr auto select_cancelled_token = std::numeric_limits<select_waiter_token>::max();
+
+    template <select_op... Ops>
+    using select_wait_states = std::tuple<typename Ops::wait_state_type...>;
+
+    template <select_op... Ops>
+    [[nodiscard]] auto select_try_ready(Ops&... ops_args) -> std::optional<select_result<Ops...>>
+    {
+        auto result = std::optional<select_result<Ops...>>{};
+
+        ([&]<std::size_t... indices>(std::index_sequence<indices...>)
+         {
+             ([&]<std::size_t channel_index>(auto& op, constant<channel_index>)
+              {
+                  constexpr auto op_base_token = select_ops_base_tokens<Ops...>[channel_index];
+
+                  if (auto const ready_alternative = op.submit_if_ready())
+                  {
+                      result.emplace(
+                          op.get_result(*ready_alternative),
+                          op_base_token + *ready_alternative);
+
+                      return true;
+                  }
+
+                  return false;
+              }(ops_args, constant<indices>{})
+              or ...);
+         }(std::index_sequence_for<Ops...>{}));
+
+        return result;
+    }
+
+    // A waitable operation of a select, with its type erased.
+    // The waiting steps of select loop over descriptors, so they are compiled once per executor,
+    // and each operation once per operation type, rather than once per combination of operations.
+    template <asio::execution::executor Executor>
+    struct select_op_descriptor
+    {
+        void* op = nullptr;
+        void* wait_state = nullptr;
+        select_waiter_token base_token = 0;
+        std::size_t num_alternatives = 0;
+
+        auto (*submit_with_wait)(
+            void* op,
+            select_wait_context<Executor>& wait_ctx,
+            select_waiter_token base_token,
+            void* wait_state)
+            -> std::optional<std::size_t>
+            = nullptr;
+
+        void (*clear_wait)(
+            void* op,
+            std::optional<std::size_t> successful_alternative,
+            void* wait_state)
+            = nullptr;
+    };
+
+    template <waitable_select_op Op>
+    struct select_op_thunks
+    {
+        using executor_type = typename Op::executor_type;
+        using wait_state_type = typename Op::wait_state_type;
+
+        [[nodiscard]] static auto submit_with_wait(
+            void* const op,
+            select_wait_context<executor_type>& wait_ctx,
+            select_waiter_token const base_token,
+            void* const wait_state)
+            -> std::optional<std::size_t>
+        {
+            return static_cast<Op*>(op)->submit_with_wait(
+                wait_ctx,
+                base_token,
+                *static_cast<wait_state_type*>(wait_state));
+        }
+
+        static void clear_wait(
+            void* const op,
+            std::optional<std::size_t> const successful_alternative,
+            void* const wait_state)
+        {
+            static_cast<Op*>(op)->clear_wait(
+                successful_alternative,
+                *static_cast<wait_state_type*>(wait_state));
+        }
+    };
+
+    template <asio::execution::executor Executor, select_op... Ops>
+    [[nodiscard]] auto make_select_op_descriptors(
+        select_wait_states<Ops...>& ops_wait_states,
+        Ops&... ops_args)
+        -> std::array<select_op_descriptor<Executor>, sizeof...(Ops)>
+    {
+        return [&]<std::size_t... indices>(std::index_sequence<indices...>)
+        {
+            return std::array{
+                select_op_descriptor<Executor>{
+                    .op = &ops_args,
+                    .wait_state = &std::get<indices>(ops_wait_states),
+                    .base_token = select_ops_base_tokens<Ops...>[indices],
+                    .num_alternatives = Ops::num_alternatives,
+                    .submit_with_wait = &select_op_thunks<Ops>::submit_with_wait,
+                    .clear_wait = &select_op_thunks<Ops>::clear_wait,
+                }...,
+            };
+        }(std::index_sequence_for<Ops...>{});
+    }
+
+    template <asio::execution::executor Executor>
+    [[nodiscard]] auto submit_select_ops_with_wait(
+        select_wait_context<Executor>& wait_ctx,
+        std::span<select_op_descriptor<Executor> const> const ops)
+        -> std::optional<select_waiter_token>
+    {
+        for (auto const& op : ops)
+        {
+            if (auto const ready_alternative = op.submit_with_wait(op.op, wait_ctx, op.base_token, op.wait_state))
+            {
+                return op.base_token + *ready_alternative;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // Returns the index of the operation the token belongs to, if any.
+    template <asio::execution::executor Executor>
+    [[nodiscard]] auto clear_select_ops_wait(
+        select_waiter_token const success_token,
+        std::span<select_op_descriptor<Executor> const> const ops)
+        -> std::optional<std::size_t>
+    {
+        auto successful_op = std::optional<std::size_t>{};
+
+        for (auto i = std::size_t{0}; i < ops.size(); ++i)
+        {
+            auto const& op = ops[i];
+            auto successful_alternative = std::optional<std::size_t>{};
+
+            if (success_token >= op.base_token
+                and success_token < op.base_token + op.num_alternatives)
+            {
+                successful_op = i;
+                successful_alternative = success_token - op.base_token;
+            }
+
+            op.clear_wait(op.op, successful_alternative, op.wait_state);
+        }
+
+        return successful_op;
+    }
+
+    template <select_op... Ops>
+    struct select_result_factory
+    {
+        template <select_op Op>
+        [[nodiscard]] static auto make(
+            void* const op,
+            std::size_t const successful_alternative,
+            select_waiter_token const success_token)
+            -> select_result<Ops...>
+        {
+            return select_result<Ops...>{
+                static_cast<Op*>(op)->get_result(successful_alternative),
+                success_token};
+        }
+
+        static constexpr auto table = std::array{&make<Ops>...};
+    };
+
+    template <asio::execution::executor Executor, select_op... Ops>
+    [[nodiscard]] auto select_submit_with_wait(
+        select_wait_context<Executor>& wait_ctx,
+        select_wait_states<Ops...>& ops_wait_states,
+        Ops&... ops_args)
+        -> std::optional<select_waiter_token>
+    {
+        auto const descriptors = make_select_op_descriptors<Executor>(ops_wait_states, ops_args...);
+
+        return submit_select_ops_with_wait<Executor>(wait_ctx, descriptors);
+    }
+
+    template <select_op... Ops>
+    [[nodiscard]] auto select_clear_wait(
+        select_waiter_token const success_token,
+        select_wait_states<Ops...>& ops_wait_states,
+        Ops&... ops_args)
+        -> std::optional<select_result<Ops...>>
+    {
+        using executor_type = typename head_t<Ops...>::executor_type;
+
+        auto const descriptors = make_select_op_descriptors<executor_type>(ops_wait_states, ops_args...);
+        auto const successful_op = clear_select_ops_wait<executor_type>(success_token, descriptors);
+        if (not successful_op)
+        {
+            return std::nullopt;
+        }
+
+        auto const& op = descriptors[*successful_op];
+
+        return select_result_factory<Ops...>::table[*successful_op](
+            op.op,
+            success_token - op.base_token,
+            success_token);
+    }
+
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+    template <asio::execution::executor Executor>
+    class select_cancellation_handler
+    {
+      public:
+        explicit select_cancellation_handler(select_wait_context<Executor>& ctx) noexcept
+          : ctx_{&ctx}
+        {
+        }
+
+        void operator()(asio::cancellation_type const type)
+        {
+            if (type != asio::cancellation_type::none and claim(*ctx_))
+            {
+                // No operation has completed, the select can be abandoned without side effects.
+                complete(*ctx_, select_cancelled_token);
+            }
+        }
+
+      private:
+        select_wait_context<Executor>* ctx_;
+    };
+
+    template <asio::execution::executor Executor>
+    void connect_cancellation(select_wait_context<Executor>& ctx, asio::cancellation_slot slot)
+    {
+        if (slot.is_connected())
+        {
+            ctx.cancellation_slot = slot;
+            slot.template emplace<select_cancellation_handler<Executor>>(ctx);
+        }
+    }
+
+    template <asio::execution::executor Executor>
+    void disconnect_cancellation(select_wait_context<Executor>& ctx)
+    {
+        if (ctx.cancellation_slot.is_connected())
+        {
+            ctx.cancellation_slot.clear();
+        }
+    }
+#endif
 }  // namespace asiochan::detail
@@ -1,13 +1,19 @@
 #pragma once
 
 #include <cassert>
+#include <cstring>
+#include <memory>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 #include "asiochan/sendable.hpp"
 
 namespace asiochan::detail
 {
+    // Holds a single value, in flight between a waiter and a channel.
+    // Unlike the slots of a ring buffer, whose occupancy follows from its head and count,
+    // nothing else records whether a slot is full, so the value stays in a std::optional.
     template <sendable T>
     class send_slot
     {
@@ -24,11 +30,53 @@ namespace asiochan::detail
             value_.emplace(std::move(value));
         }
 
+        template <typename... Args>
+        void emplace(Args&&... args)
+        {
+            assert(not value_.has_value());
+            value_.emplace(std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] auto get() noexcept -> T&
+        {
+            assert(value_.has_value());
+            return *value_;
+        }
+
+        void reset() noexcept
+        {
+            value_.reset();
+        }
+
+        // Moves the value into uninitialized storage.
+        void move_to(T* const storage) noexcept
+        {
+            assert(value_.has_value());
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                std::memcpy(static_cast<void*>(storage), std::addressof(*value_), sizeof(T));
+            }
+            else
+            {
+                std::construct_at(storage, std::move(*value_));
+            }
+            value_.reset();
+        }
+
+        // Moves the value out of storage, leaving it uninitialized.
+        void move_from(T* const storage) noexcept
+        {
+            assert(not value_.has_value());
+            value_.emplace(std::move(*storage));
+            std::destroy_at(storage);
+        }
+
         friend void transfer(send_slot& from, send_slot& to) noexcept
         {
             assert(from.value_.has_value());
             assert(not to.value_.has_value());
             to.value_.emplace(*std::move(from.value_));
+            from.value_.reset();
         }
 
       private:
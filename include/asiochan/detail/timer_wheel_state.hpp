@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "asiochan/asio.hpp"
+
+namespace asiochan::detail
+{
+    struct timer_wheel_node
+    {
+        using expire_fn = void (*)(timer_wheel_node& node);
+
+        expire_fn on_expire = nullptr;
+        std::size_t rounds = 0;
+        std::size_t slot = 0;
+        bool linked = false;
+        timer_wheel_node* prev = nullptr;
+        timer_wheel_node* next = nullptr;
+    };
+
+    template <asio::execution::executor Executor>
+    class timer_wheel_state
+      : public std::enable_shared_from_this<timer_wheel_state<Executor>>
+    {
+      public:
+        using clock_type = std::chrono::steady_clock;
+        using duration = clock_type::duration;
+        using time_point = clock_type::time_point;
+        using timer_type = asio::basic_waitable_timer<clock_type, asio::wait_traits<clock_type>, Executor>;
+
+        timer_wheel_state(Executor const& executor, duration const tick, std::size_t const num_slots)
+          : timer_{executor}
+          , tick_{tick}
+          , slots_(num_slots)
+        {
+            assert(tick > duration::zero());
+            assert(num_slots > 0);
+        }
+
+        [[nodiscard]] auto get_executor() const -> Executor
+        {
+            return timer_.get_executor();
+        }
+
+        [[nodiscard]] auto tick() const noexcept -> duration
+        {
+            return tick_;
+        }
+
+        [[nodiscard]] auto num_pending() -> std::size_t
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            return num_pending_;
+        }
+
+        void schedule(timer_wheel_node& node, duration const timeout)
+        {
+            assert(not node.linked);
+            assert(node.on_expire);
+
+            auto const lock = std::scoped_lock{mutex_};
+            auto const now = clock_type::now();
+
+            if (num_pending_ == 0 and not armed_)
+            {
+                // The wheel was idle, resynchronize the tick reference point.
+                last_tick_ = now;
+            }
+
+            // Round up, so that the node never expires early.
+            auto const span = std::max((now - last_tick_) + timeout, duration{1});
+            auto const ticks = static_cast<std::size_t>((span.count() + tick_.count() - 1) / tick_.count());
+
+            node.rounds = (ticks - 1) / slots_.size();
+            node.slot = (current_ + ticks) % slots_.size();
+            link(node);
+            ++num_pending_;
+
+            if (not armed_)
+            {
+                arm();
+            }
+        }
+
+        void cancel(timer_wheel_node& node)
+        {
+            auto const lock = std::scoped_lock{mutex_};
+
+            if (node.linked)
+            {
+                unlink(node);
+                --num_pending_;
+            }
+        }
+
+      private:
+        struct slot_list
+        {
+            timer_wheel_node* first = nullptr;
+            timer_wheel_node* last = nullptr;
+        };
+
+        std::mutex mutex_;
+        timer_type timer_;
+        duration tick_;
+        std::vector<slot_list> slots_;
+        std::size_t current_ = 0;
+        std::size_t num_pending_ = 0;
+        time_point last_tick_ = {};
+        bool armed_ = false;
+
+        void link(timer_wheel_node& node) noexcept
+        {
+            auto& slot = slots_[node.slot];
+
+            node.prev = slot.last;
+            node.next = nullptr;
+            node.linked = true;
+
+            if (not slot.first)
+            {
+                slot.first = &node;
+            }
+            else
+            {
+                slot.last->next = &node;
+            }
+
+            slot.last = &node;
+        }
+
+        void unlink(timer_wheel_node& node) noexcept
+        {
+            auto& slot = slots_[node.slot];
+
+            if (node.prev)
+            {
+                node.prev->next = node.next;
+            }
+            else
+            {
+                slot.first = node.next;
+            }
+
+            if (node.next)
+            {
+                node.next->prev = node.prev;
+            }
+            else
+            {
+                slot.last = node.prev;
+            }
+
+            node.prev = nullptr;
+            node.next = nullptr;
+            node.linked = false;
+        }
+
+        void arm()
+        {
+            armed_ = true;
+            timer_.expires_at(last_tick_ + tick_);
+            timer_.async_wait(
+                [self = this->shared_from_this()](system::error_code const&)
+                {
+                    self->on_tick();
+                });
+        }
+
+        void on_tick()
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            auto const now = clock_type::now();
+
+            armed_ = false;
+
+            while (num_pending_ != 0 and last_tick_ + tick_ <= now)
+            {
+                last_tick_ += tick_;
+                current_ = (current_ + 1) % slots_.size();
+
+                auto node = slots_[current_].first;
+                while (node)
+                {
+                    auto const next = node->next;
+
+                    if (node->rounds == 0)
+                    {
+                        unlink(*node);
+                        --num_pending_;
+                        node->on_expire(*node);
+                    }
+                    else
+                    {
+                        --node->rounds;
+                    }
+
+                    node = next;
+                }
+            }
+
+            if (num_pending_ != 0)
+            {
+                arm();
+            }
+        }
+    };
+}  // namespace asiochan::detail
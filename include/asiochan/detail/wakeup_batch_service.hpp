@@ -0,0 +1,130 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <utility>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+
+namespace asiochan::detail
+{
+    template <asio::execution::executor Executor>
+    struct select_batched_wait_context : select_promise_wait_context<Executor>
+    {
+        select_batched_wait_context* next_batched = nullptr;
+        select_waiter_token batched_token = 0;
+
+        select_batched_wait_context() noexcept
+        {
+            this->on_complete = &enqueue_wakeup;
+        }
+
+        static void enqueue_wakeup(select_wait_context<Executor>& ctx, select_waiter_token token);
+    };
+
+    // Coalesces the wake-ups of waiters on the same executor into a single posted handler,
+    // which resumes all of them in a loop.
+    template <asio::execution::executor Executor>
+    class wakeup_batch_service : public asio::execution_context::service
+    {
+      public:
+        using waiter_type = select_batched_wait_context<Executor>;
+
+        static inline asio::execution_context::id id;
+
+        explicit wakeup_batch_service(asio::execution_context& context)
+          : asio::execution_context::service{context}
+        {
+        }
+
+        void enqueue(waiter_type& waiter, Executor const& executor)
+        {
+            auto const lock = std::scoped_lock{mutex_};
+
+            for (auto& batch : batches_)
+            {
+                if (batch.executor == executor)
+                {
+                    // A drain is already scheduled on this executor.
+                    batch.last->next_batched = &waiter;
+                    batch.last = &waiter;
+                    return;
+                }
+            }
+
+            auto const batch = batches_.insert(batches_.end(), batch_type{executor, &waiter, &waiter});
+            asio::post(
+                executor,
+                [this, batch]()
+                {
+                    drain(batch);
+                });
+        }
+
+      private:
+        struct batch_type
+        {
+            Executor executor;
+            waiter_type* first;
+            waiter_type* last;
+        };
+
+        std::mutex mutex_;
+        std::list<batch_type> batches_;
+
+        // Drains still queued when the context shuts down are destroyed without running.
+        // Destroy their waiters too, as the context does with the handlers of waiters that are not batched.
+        void shutdown() override
+        {
+            auto batches = std::list<batch_type>{};
+            {
+                auto const lock = std::scoped_lock{mutex_};
+                batches.swap(batches_);
+            }
+
+            for (auto& batch : batches)
+            {
+                auto waiter = batch.first;
+                while (waiter)
+                {
+                    // The waiter is destroyed with its promise.
+                    auto const next = std::exchange(waiter->next_batched, nullptr);
+                    waiter->promise.abandon();
+                    waiter = next;
+                }
+            }
+        }
+
+        void drain(typename std::list<batch_type>::iterator const batch)
+        {
+            auto waiter = static_cast<waiter_type*>(nullptr);
+            {
+                auto const lock = std::scoped_lock{mutex_};
+                waiter = batch->first;
+                batches_.erase(batch);
+            }
+
+            while (waiter)
+            {
+                // The waiter may be destroyed once resumed.
+                auto const next = std::exchange(waiter->next_batched, nullptr);
+                waiter->promise.resume_with_value(waiter->batched_token);
+                waiter = next;
+            }
+        }
+    };
+
+    template <asio::execution::executor Executor>
+    void select_batched_wait_context<Executor>::enqueue_wakeup(
+        select_wait_context<Executor>& ctx,
+        select_waiter_token const token)
+    {
+        auto& self = static_cast<select_batched_wait_context&>(ctx);
+        self.batched_token = token;
+
+        auto const executor = self.promise.get_executor();
+        auto& context = asio::query(executor, asio::execution::context);
+        asio::use_service<wakeup_batch_service<Executor>>(context).enqueue(self, executor);
+    }
+}  // namespace asiochan::detail
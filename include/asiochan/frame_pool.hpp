@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace asiochan
+{
+    struct frame_pool_stats
+    {
+        // Frames allocated from the pool of the thread.
+        std::uint64_t hits = 0;
+        // Frames allocated with the global operator new, because the pool was empty or the frame too large.
+        std::uint64_t misses = 0;
+        // Frames freed to the global operator delete, because the pool was full or the frame too large.
+        std::uint64_t releases = 0;
+        // Frames currently kept by the pool.
+        std::size_t cached = 0;
+    };
+
+    namespace detail
+    {
+        // A per-thread cache of operation frames, in size classes.
+        // Frames are returned to the pool of the thread that frees them.
+        class frame_pool
+        {
+          public:
+            static constexpr auto size_granularity = std::size_t{64};
+            static constexpr auto num_size_classes = std::size_t{32};
+            static constexpr auto max_cached_per_class = std::size_t{16};
+
+            frame_pool() noexcept = default;
+
+            frame_pool(frame_pool const&) = delete;
+            auto operator=(frame_pool const&) -> frame_pool& = delete;
+
+            ~frame_pool() noexcept
+            {
+                for (auto& free_list : free_lists_)
+                {
+                    while (free_list)
+                    {
+                        ::operator delete(std::exchange(free_list, free_list->next));
+                    }
+                }
+                thread_pool_destroyed() = true;
+            }
+
+            // Null while the thread is exiting, once the pool was destroyed.
+            [[nodiscard]] static auto this_thread() noexcept -> frame_pool*
+            {
+                thread_local auto pool = frame_pool{};
+
+                return thread_pool_destroyed() ? nullptr : &pool;
+            }
+
+            [[nodiscard]] static auto allocate(std::size_t const size) -> void*
+            {
+                auto const pool = this_thread();
+                auto const size_class = size_class_of(size);
+                if (size_class >= num_size_classes)
+                {
+                    if (pool)
+                    {
+                        ++pool->stats_.misses;
+                    }
+                    return ::operator new(size);
+                }
+
+                if (pool)
+                {
+                    if (auto const block = pool->free_lists_[size_class])
+                    {
+                        pool->free_lists_[size_class] = block->next;
+                        --pool->num_cached_[size_class];
+                        ++pool->stats_.hits;
+                        return block;
+                    }
+
+                    ++pool->stats_.misses;
+                }
+
+                // Always the full size of the class, the frame may be cached by another thread.
+                return ::operator new(class_size(size_class));
+            }
+
+            static void deallocate(void* const pointer, std::size_t const size) noexcept
+            {
+                auto const pool = this_thread();
+                auto const size_class = size_class_of(size);
+                if (not pool or size_class >= num_size_classes
+                    or pool->num_cached_[size_class] == max_cached_per_class)
+                {
+                    if (pool)
+                    {
+                        ++pool->stats_.releases;
+                    }
+                    ::operator delete(pointer);
+                    return;
+                }
+
+                pool->free_lists_[size_class] = ::new (pointer) free_block{pool->free_lists_[size_class]};
+                ++pool->num_cached_[size_class];
+            }
+
+            [[nodiscard]] auto stats() const noexcept -> frame_pool_stats
+            {
+                auto result = stats_;
+                for (auto const num_cached : num_cached_)
+                {
+                    result.cached += num_cached;
+                }
+
+                return result;
+            }
+
+          private:
+            struct free_block
+            {
+                free_block* next = nullptr;
+            };
+
+            std::array<free_block*, num_size_classes> free_lists_ = {};
+            std::array<std::size_t, num_size_classes> num_cached_ = {};
+            frame_pool_stats stats_ = {};
+
+            // Trivially destructible, so that it can still be read after the pool of the thread was destroyed.
+            [[nodiscard]] static auto thread_pool_destroyed() noexcept -> bool&
+            {
+                thread_local auto destroyed = false;
+
+                return destroyed;
+            }
+
+            [[nodiscard]] static constexpr auto size_class_of(std::size_t const size) noexcept -> std::size_t
+            {
+                return (size + size_granularity - 1) / size_granularity - 1;
+            }
+
+            [[nodiscard]] static constexpr auto class_size(std::size_t const size_class) noexcept -> std::size_t
+            {
+                return (size_class + 1) * size_granularity;
+            }
+        };
+    }  // namespace detail
+
+    [[nodiscard]] inline auto this_thread_frame_pool_stats() noexcept -> frame_pool_stats
+    {
+        auto const pool = detail::frame_pool::this_thread();
+
+        return pool ? pool->stats() : frame_pool_stats{};
+    }
+
+    // Allocates from the frame pool of the calling thread.
+    template <typename T>
+    class frame_pool_allocator
+    {
+      public:
+        using value_type = T;
+
+        frame_pool_allocator() noexcept = default;
+
+        template <typename U>
+        frame_pool_allocator(frame_pool_allocator<U> const&) noexcept
+        {
+        }
+
+        [[nodiscard]] auto allocate(std::size_t const n) -> T*
+        {
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            return static_cast<T*>(detail::frame_pool::allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* const pointer, std::size_t const n) noexcept
+        {
+            detail::frame_pool::deallocate(pointer, n * sizeof(T));
+        }
+
+        [[nodiscard]] friend auto operator==(
+            frame_pool_allocator const& lhs,
+            frame_pool_allocator const& rhs) noexcept -> bool
+            = default;
+    };
+}  // namespace asiochan
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace asiochan
+{
+    struct lock_stats
+    {
+        std::uint64_t acquisitions = 0;
+        std::uint64_t contended = 0;
+        std::chrono::nanoseconds blocked = {};
+    };
+
+    class lock_profile
+    {
+      public:
+        void record(bool const contended, std::chrono::nanoseconds const blocked = {}) noexcept
+        {
+            acquisitions_.fetch_add(1, std::memory_order_relaxed);
+            if (contended)
+            {
+                contended_.fetch_add(1, std::memory_order_relaxed);
+                blocked_ns_.fetch_add(static_cast<std::uint64_t>(blocked.count()), std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] auto snapshot() const noexcept -> lock_stats
+        {
+            return {
+                .acquisitions = acquisitions_.load(std::memory_order_relaxed),
+                .contended = contended_.load(std::memory_order_relaxed),
+                .blocked = std::chrono::nanoseconds{
+                    static_cast<std::chrono::nanoseconds::rep>(blocked_ns_.load(std::memory_order_relaxed))},
+            };
+        }
+
+        void reset() noexcept
+        {
+            acquisitions_.store(0, std::memory_order_relaxed);
+            contended_.store(0, std::memory_order_relaxed);
+            blocked_ns_.store(0, std::memory_order_relaxed);
+        }
+
+      private:
+        std::atomic<std::uint64_t> acquisitions_ = 0;
+        std::atomic<std::uint64_t> contended_ = 0;
+        std::atomic<std::uint64_t> blocked_ns_ = 0;
+    };
+
+    namespace detail
+    {
+        inline void profiled_lock(std::mutex& mutex, lock_profile& profile)
+        {
+            if (mutex.try_lock())
+            {
+                profile.record(false);
+                return;
+            }
+
+            auto const start = std::chrono::steady_clock::now();
+            mutex.lock();
+            profile.record(true, std::chrono::steady_clock::now() - start);
+        }
+
+        inline auto profiled_try_lock(std::mutex& mutex, lock_profile& profile) -> bool
+        {
+            if (mutex.try_lock())
+            {
+                profile.record(false);
+                return true;
+            }
+
+            return false;
+        }
+    }  // namespace detail
+
+    // A mutex that records how often it was acquired with contention, and for how long lockers were blocked.
+    class profiled_mutex
+    {
+      public:
+        void lock()
+        {
+            detail::profiled_lock(mutex_, profile_);
+        }
+
+        [[nodiscard]] auto try_lock() -> bool
+        {
+            return detail::profiled_try_lock(mutex_, profile_);
+        }
+
+        void unlock()
+        {
+            mutex_.unlock();
+        }
+
+        [[nodiscard]] auto profile() noexcept -> lock_profile&
+        {
+            return profile_;
+        }
+
+        [[nodiscard]] auto profile() const noexcept -> lock_profile const&
+        {
+            return profile_;
+        }
+
+      private:
+        std::mutex mutex_;
+        lock_profile profile_;
+    };
+
+    // Aggregated profile of the mutexes of all select wait contexts.
+    // Only recorded when compiled with ASIOCHAN_PROFILE_SELECT_LOCKS.
+    [[nodiscard]] inline auto select_lock_profile() noexcept -> lock_profile&
+    {
+        static auto profile = lock_profile{};
+        return profile;
+    }
+
+    namespace detail
+    {
+        class select_profiled_mutex
+        {
+          public:
+            void lock()
+            {
+                profiled_lock(mutex_, select_lock_profile());
+            }
+
+            [[nodiscard]] auto try_lock() -> bool
+            {
+                return profiled_try_lock(mutex_, select_lock_profile());
+            }
+
+            void unlock()
+            {
+                mutex_.unlock();
+            }
+
+          private:
+            std::mutex mutex_;
+        };
+    }  // namespace detail
+}  // namespace asiochan
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "asiochan/any_channel.hpp"
+#include "asiochan/asio.hpp"
+#include "asiochan/channel.hpp"
+#include "asiochan/channel_concepts.hpp"
+#include "asiochan/sendable.hpp"
+
+namespace asiochan
+{
+    namespace detail
+    {
+        template <sendable_value T, asio::execution::executor Executor, typename Compare, std::size_t num_channels>
+        class merge_state
+        {
+          public:
+            using channel_type = basic_any_read_channel<T, Executor>;
+
+            merge_state(Compare compare, std::array<channel_type, num_channels> channels)
+              : compare_{std::move(compare)}
+              , channels_{std::move(channels)}
+            {
+                for (auto i = std::size_t{0}; i < num_channels; ++i)
+                {
+                    missing_[i] = i;
+                }
+            }
+
+            [[nodiscard]] auto try_read() -> std::optional<T>
+            {
+                while (num_missing_ != 0)
+                {
+                    auto const index = missing_[num_missing_ - 1];
+                    auto value = channels_[index].try_read();
+                    if (not value)
+                    {
+                        return std::nullopt;
+                    }
+                    push_head(index, std::move(*value));
+                }
+
+                return pop_head();
+            }
+
+            [[nodiscard]] static auto read(std::shared_ptr<merge_state> state) -> asio::awaitable<T, Executor>
+            {
+                // Only the channels whose head was taken are waited on, one at a time.
+                while (state->num_missing_ != 0)
+                {
+                    auto const index = state->missing_[state->num_missing_ - 1];
+                    auto value = co_await state->channels_[index].read();
+                    state->push_head(index, std::move(value));
+                }
+
+                co_return state->pop_head();
+            }
+
+            // Starts forwarding the merged values into an unbuffered channel, on the first call.
+            [[nodiscard]] static auto forwarded(std::shared_ptr<merge_state> const& state, Executor const& executor)
+                -> channel_type
+            {
+                if (not state->forwarded_)
+                {
+                    state->forwarded_.emplace();
+                    asio::co_spawn(executor, forward(state, *state->forwarded_), asio::detached);
+                }
+
+                return *state->forwarded_;
+            }
+
+          private:
+            using forwarded_channel_type = basic_channel<T, 0, Executor>;
+
+            Compare compare_;
+            std::array<channel_type, num_channels> channels_;
+            std::array<std::optional<T>, num_channels> heads_;
+            // Channels with a head, ordered as a heap with the least head at the front.
+            std::array<std::size_t, num_channels> heap_ = {};
+            std::size_t heap_size_ = 0;
+            // Channels without a head, waited on from the back.
+            std::array<std::size_t, num_channels> missing_ = {};
+            std::size_t num_missing_ = num_channels;
+            std::optional<forwarded_channel_type> forwarded_;
+
+            // Runs for as long as the executor, and keeps the merge alive with it.
+            [[nodiscard]] static auto forward(std::shared_ptr<merge_state> state, forwarded_channel_type out)
+                -> asio::awaitable<void, Executor>
+            {
+                while (true)
+                {
+                    co_await out.write(co_await read(state));
+                }
+            }
+
+            // Heads that compare equal are taken in channel order.
+            [[nodiscard]] auto heap_before(std::size_t const lhs, std::size_t const rhs) -> bool
+            {
+                if (compare_(*heads_[rhs], *heads_[lhs]))
+                {
+                    return true;
+                }
+
+                return not compare_(*heads_[lhs], *heads_[rhs]) and rhs < lhs;
+            }
+
+            void push_head(std::size_t const index, T&& value)
+            {
+                heads_[index].emplace(std::move(value));
+                --num_missing_;
+                heap_[heap_size_++] = index;
+                std::push_heap(
+                    heap_.begin(),
+                    heap_.begin() + heap_size_,
+                    [this](std::size_t const lhs, std::size_t const rhs)
+                    {
+                        return heap_before(lhs, rhs);
+                    });
+            }
+
+            [[nodiscard]] auto pop_head() -> T
+            {
+                std::pop_heap(
+                    heap_.begin(),
+                    heap_.begin() + heap_size_,
+                    [this](std::size_t const lhs, std::size_t const rhs)
+                    {
+                        return heap_before(lhs, rhs);
+                    });
+                auto const index = heap_[--heap_size_];
+                auto value = std::move(*heads_[index]);
+                heads_[index].reset();
+                missing_[num_missing_++] = index;
+
+                return value;
+            }
+        };
+    }  // namespace detail
+
+    // Reads from several channels, each sorted by the comparator, as a single sorted stream.
+    // A value is returned once every channel has a value ahead of it, so all channels must keep being written to.
+    // Copies share the merge, which supports one read at a time.
+    template <sendable_value T, asio::execution::executor Executor, typename Compare, std::size_t num_channels>
+    class basic_merged_channel
+    {
+      public:
+        using executor_type = Executor;
+        using send_type = T;
+        using channel_type = basic_any_read_channel<T, Executor>;
+
+        [[nodiscard]] basic_merged_channel(Compare compare, std::array<channel_type, num_channels> channels)
+          : state_{std::make_shared<state_type>(std::move(compare), std::move(channels))}
+        {
+        }
+
+        [[nodiscard]] auto try_read() -> std::optional<T>
+        {
+            return state_->try_read();
+        }
+
+        [[nodiscard]] auto read() -> asio::awaitable<T, Executor>
+        {
+            return state_type::read(state_);
+        }
+
+        // A read handle to the merged stream, for use in select or wherever a readable channel is expected.
+        // On the first call, a coroutine is started on the executor, which forwards the merged values
+        // into an unbuffered channel. From then on, the merge must only be read through the handle.
+        [[nodiscard]] auto read_channel(Executor const& executor) -> channel_type
+        {
+            return state_type::forwarded(state_, executor);
+        }
+
+        [[nodiscard]] friend auto operator==(
+            basic_merged_channel const& lhs,
+            basic_merged_channel const& rhs) noexcept -> bool
+            = default;
+
+      private:
+        using state_type = detail::merge_state<T, Executor, Compare, num_channels>;
+
+        std::shared_ptr<state_type> state_;
+    };
+
+    // clang-format off
+    template <typename Compare, any_readable_channel_type Channel, any_readable_channel_type... Channels>
+    requires (std::same_as<typename Channel::send_type, typename Channels::send_type> and ...)
+             and (std::same_as<typename Channel::executor_type, typename Channels::executor_type> and ...)
+    [[nodiscard]] auto merge_channels(Compare compare, Channel const& channel, Channels const&... channels)
+        -> basic_merged_channel<
+            typename Channel::send_type,
+            typename Channel::executor_type,
+            Compare,
+            1 + sizeof...(Channels)>
+    // clang-format on
+    {
+        using send_type = typename Channel::send_type;
+        using executor_type = typename Channel::executor_type;
+        using channel_type = basic_any_read_channel<send_type, executor_type>;
+
+        return {
+            std::move(compare),
+            std::array{channel_type{channel}, channel_type{channels}...},
+        };
+    }
+}  // namespace asiochan
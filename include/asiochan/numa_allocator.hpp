@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace asiochan
+{
+    inline constexpr auto any_numa_node = -1;
+
+    // Whether numa_allocator maps and binds pages on single node machines too.
+    enum class numa_binding
+    {
+        multi_node_only,
+        always,
+    };
+
+    // The number of NUMA nodes of the machine, 1 where this cannot be determined.
+    [[nodiscard]] inline auto numa_node_count() noexcept -> int
+    {
+        static auto const count = []() noexcept
+        {
+            auto result = 0;
+#if defined(__linux__)
+            auto error = std::error_code{};
+            for (auto it = std::filesystem::directory_iterator{"/sys/devices/system/node", error};
+                 not error and it != std::filesystem::directory_iterator{};
+                 it.increment(error))
+            {
+                auto const name = it->path().filename().string();
+                if (name.starts_with("node") and name.size() > 4
+                    and name.find_first_not_of("0123456789", 4) == std::string::npos)
+                {
+                    ++result;
+                }
+            }
+#endif
+            return result > 0 ? result : 1;
+        }();
+
+        return count;
+    }
+
+    // The NUMA node of the CPU the calling thread currently runs on, 0 where this cannot be determined.
+    [[nodiscard]] inline auto current_numa_node() noexcept -> int
+    {
+#if defined(__linux__) && defined(SYS_getcpu)
+        auto cpu = 0u;
+        auto node = 0u;
+        if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        {
+            return static_cast<int>(node);
+        }
+#endif
+        return 0;
+    }
+
+    namespace detail
+    {
+        // From <numaif.h>, which is only available with libnuma installed.
+        inline constexpr auto mpol_preferred = 1;
+
+        [[nodiscard]] inline auto numa_allocation_enabled(int const node, numa_binding const binding) noexcept
+            -> bool
+        {
+#if defined(__linux__) && defined(SYS_mbind)
+            return node >= 0
+                   and node < numa_node_count()
+                   and node < std::numeric_limits<unsigned long>::digits
+                   and (binding == numa_binding::always or numa_node_count() > 1);
+#else
+            static_cast<void>(node);
+            static_cast<void>(binding);
+            return false;
+#endif
+        }
+
+        [[nodiscard]] inline auto numa_allocate(std::size_t const bytes, int const node) -> void*
+        {
+#if defined(__linux__) && defined(SYS_mbind)
+            auto const ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED)
+            {
+                throw std::bad_alloc{};
+            }
+
+            // Pages are placed when first touched, so binding before construction is sufficient.
+            // When the policy cannot be set, the pages are placed on the node of the constructing thread.
+            auto const node_mask = 1ul << node;
+            ::syscall(
+                SYS_mbind,
+                ptr,
+                bytes,
+                mpol_preferred,
+                &node_mask,
+                std::numeric_limits<unsigned long>::digits,
+                0u);
+
+            return ptr;
+#else
+            static_cast<void>(bytes);
+            static_cast<void>(node);
+            throw std::bad_alloc{};
+#endif
+        }
+
+        inline void numa_deallocate(void* const ptr, std::size_t const bytes) noexcept
+        {
+#if defined(__linux__)
+            ::munmap(ptr, bytes);
+#else
+            static_cast<void>(ptr);
+            static_cast<void>(bytes);
+#endif
+        }
+    }  // namespace detail
+
+    // Allocates memory on a given NUMA node.
+    // Falls back to the default allocator when no node is specified, and on single node machines
+    // unless numa_binding::always is given.
+    template <typename T>
+    class numa_allocator
+    {
+      public:
+        using value_type = T;
+
+        numa_allocator() noexcept = default;
+
+        explicit numa_allocator(int const node, numa_binding const binding = numa_binding::multi_node_only) noexcept
+          : node_{node}
+          , binding_{binding}
+        {
+        }
+
+        template <typename U>
+        numa_allocator(numa_allocator<U> const& other) noexcept
+          : node_{other.node()}
+          , binding_{other.binding()}
+        {
+        }
+
+        [[nodiscard]] auto allocate(std::size_t const n) -> T*
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length{};
+            }
+
+            if (not detail::numa_allocation_enabled(node_, binding_))
+            {
+                return std::allocator<T>{}.allocate(n);
+            }
+
+            return static_cast<T*>(detail::numa_allocate(n * sizeof(T), node_));
+        }
+
+        void deallocate(T* const ptr, std::size_t const n) noexcept
+        {
+            if (not detail::numa_allocation_enabled(node_, binding_))
+            {
+                std::allocator<T>{}.deallocate(ptr, n);
+                return;
+            }
+
+            detail::numa_deallocate(ptr, n * sizeof(T));
+        }
+
+        [[nodiscard]] auto node() const noexcept -> int
+        {
+            return node_;
+        }
+
+        [[nodiscard]] auto binding() const noexcept -> numa_binding
+        {
+            return binding_;
+        }
+
+        template <typename U>
+        [[nodiscard]] friend auto operator==(
+            numa_allocator const& lhs,
+            numa_allocator<U> const& rhs) noexcept -> bool
+        {
+            return lhs.node() == rhs.node() and lhs.binding() == rhs.binding();
+        }
+
+      private:
+        int node_ = any_numa_node;
+        numa_binding binding_ = numa_binding::multi_node_only;
+    };
+}  // namespace asiochan
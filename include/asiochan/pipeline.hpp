@@ -0,0 +1,453 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/channel.hpp"
+#include "asiochan/channel_concepts.hpp"
+#include "asiochan/read_op.hpp"
+#include "asiochan/select.hpp"
+#include "asiochan/sendable.hpp"
+#include "asiochan/timeout_op.hpp"
+#include "asiochan/timer_wheel.hpp"
+
+namespace asiochan
+{
+    namespace detail
+    {
+        template <typename T>
+        inline constexpr auto is_optional = false;
+
+        template <typename T>
+        inline constexpr auto is_optional<std::optional<T>> = true;
+
+        template <typename Channel>
+        using stream_value_t = typename Channel::send_type::value_type;
+
+        inline constexpr auto stage_buff_size = channel_buff_size{16};
+
+        // Writes to bounded channels wait for space, writes to unbounded channels complete immediately.
+        template <typename Channel>
+        auto write_stream(Channel& channel, typename Channel::send_type value)
+            -> asio::awaitable<void, typename Channel::executor_type>
+        {
+            if constexpr (std::is_void_v<decltype(channel.write(std::move(value)))>)
+            {
+                channel.write(std::move(value));
+            }
+            else
+            {
+                co_await channel.write(std::move(value));
+            }
+        }
+
+        template <typename T>
+        struct stage_task
+        {
+            std::size_t sequence = 0;
+            T value;
+        };
+
+        template <typename U>
+        struct stage_result
+        {
+            std::size_t sequence = 0;
+            std::optional<U> value;
+        };
+
+        template <typename T, typename U, asio::execution::executor Executor>
+        struct stage_state
+        {
+            using signal_channel = basic_channel<void, unbounded_channel_buff, Executor>;
+
+            basic_channel<std::optional<stage_task<T>>, stage_buff_size, Executor> tasks;
+            // Holds at most one result per sequence number in the window, so it is never waited on.
+            basic_channel<std::optional<stage_result<U>>, unbounded_channel_buff, Executor> results;
+            // Written once by every worker, or by the collector of an ordered stage, when it finishes.
+            signal_channel done;
+            // One value per sequence number that may be dispatched before the collector reaches it.
+            signal_channel window;
+            std::mutex mutex;
+            std::exception_ptr exception;
+
+            void fail(std::exception_ptr error)
+            {
+                auto const lock = std::scoped_lock{mutex};
+                if (not exception)
+                {
+                    exception = std::move(error);
+                }
+            }
+
+            [[nodiscard]] auto failed() -> bool
+            {
+                auto const lock = std::scoped_lock{mutex};
+                return exception != nullptr;
+            }
+        };
+
+        // Writes a value to the output of a stage, or records the failure of the write.
+        template <typename T, typename U, asio::execution::executor Executor, typename Out>
+        auto write_stage_output(stage_state<T, U, Executor>& state, Out& out, std::optional<U> value)
+            -> asio::awaitable<void, Executor>
+        {
+            try
+            {
+                co_await write_stream(out, std::move(value));
+            }
+            catch (...)
+            {
+                state.fail(std::current_exception());
+            }
+        }
+
+        // Runs tasks until the end of the tasks. Once the stage failed, remaining tasks are skipped.
+        // Failures are recorded in the stage state, so that the end of the worker is always signalled.
+        template <typename T, typename U, asio::execution::executor Executor, typename Work, typename Out>
+        auto run_stage_worker(
+            std::shared_ptr<stage_state<T, U, Executor>> const state,
+            Work work,
+            Out out,
+            bool const ordered)
+            -> asio::awaitable<void, Executor>
+        {
+            try
+            {
+                while (true)
+                {
+                    auto task = co_await state->tasks.read();
+                    if (not task)
+                    {
+                        break;
+                    }
+
+                    auto result = std::optional<U>{};
+                    if (not state->failed())
+                    {
+                        try
+                        {
+                            result = work(std::move(task->value));
+                        }
+                        catch (...)
+                        {
+                            state->fail(std::current_exception());
+                        }
+                    }
+
+                    if (ordered)
+                    {
+                        // Skipped tasks still report their sequence number, so that the collector moves on.
+                        state->results.write(stage_result<U>{task->sequence, std::move(result)});
+                    }
+                    else if (result)
+                    {
+                        co_await write_stage_output(*state, out, std::move(result));
+                    }
+                }
+            }
+            catch (...)
+            {
+                state->fail(std::current_exception());
+            }
+
+            if (ordered)
+            {
+                state->results.write(std::nullopt);
+            }
+            else
+            {
+                state->done.write();
+            }
+        }
+
+        // Writes the results of an ordered stage by sequence number.
+        // Once the stage failed, results are dropped rather than written.
+        template <typename T, typename U, asio::execution::executor Executor, typename Out>
+        auto run_stage_collector(
+            std::shared_ptr<stage_state<T, U, Executor>> const state,
+            Out out,
+            std::size_t num_workers,
+            std::size_t const window_size)
+            -> asio::awaitable<void, Executor>
+        {
+            try
+            {
+                // Results that arrived ahead of their turn, at their sequence number modulo the window size.
+                auto pending = std::vector<std::optional<std::optional<U>>>(window_size);
+                auto next_sequence = std::size_t{0};
+
+                while (num_workers != 0)
+                {
+                    auto result = co_await state->results.read();
+                    if (not result)
+                    {
+                        --num_workers;
+                        continue;
+                    }
+
+                    pending[result->sequence % window_size].emplace(std::move(result->value));
+                    while (auto& slot = pending[next_sequence % window_size])
+                    {
+                        if (*slot and not state->failed())
+                        {
+                            co_await write_stage_output(*state, out, std::move(*slot));
+                        }
+                        slot.reset();
+                        ++next_sequence;
+                        state->window.write();
+                    }
+                }
+            }
+            catch (...)
+            {
+                state->fail(std::current_exception());
+            }
+
+            state->done.write();
+        }
+
+        // Feeds the values of the input to parallel workers, until the end of the input.
+        template <typename U, typename In, typename Out, typename Work>
+        auto run_stage(
+            In in,
+            Out out,
+            Work work,
+            std::size_t const parallelism,
+            bool const ordered)
+            -> asio::awaitable<void, typename In::executor_type>
+        {
+            using executor_type = typename In::executor_type;
+            using state_type = stage_state<stream_value_t<In>, U, executor_type>;
+
+            assert(parallelism > 0);
+
+            auto const executor = co_await asio::this_coro::executor;
+            auto const state = std::make_shared<state_type>();
+            auto const window_size = 2 * parallelism;
+
+            for (auto i = std::size_t{0}; i < parallelism; ++i)
+            {
+                asio::co_spawn(executor, run_stage_worker(state, work, out, ordered), asio::detached);
+            }
+
+            if (ordered)
+            {
+                for (auto i = std::size_t{0}; i < window_size; ++i)
+                {
+                    state->window.write();
+                }
+                asio::co_spawn(executor, run_stage_collector(state, out, parallelism, window_size), asio::detached);
+            }
+
+            for (auto sequence = std::size_t{0};; ++sequence)
+            {
+                auto value = co_await in.read();
+                if (not value)
+                {
+                    break;
+                }
+
+                // After a failure, the rest of the input is read but not dispatched,
+                // so that the stages before this one can still finish.
+                if (state->failed())
+                {
+                    continue;
+                }
+
+                if (ordered)
+                {
+                    co_await state->window.read();
+                }
+                co_await state->tasks.write(stage_task<stream_value_t<In>>{sequence, std::move(*value)});
+            }
+
+            for (auto i = std::size_t{0}; i < parallelism; ++i)
+            {
+                co_await state->tasks.write(std::nullopt);
+            }
+
+            for (auto i = std::size_t{0}, num_done = ordered ? 1 : parallelism; i < num_done; ++i)
+            {
+                co_await state->done.read();
+            }
+
+            co_await write_stream(out, std::nullopt);
+
+            if (state->exception)
+            {
+                std::rethrow_exception(state->exception);
+            }
+        }
+    }  // namespace detail
+
+    // clang-format off
+    // A channel of values, whose end is marked by writing std::nullopt.
+    template <typename Channel>
+    concept readable_stream_type
+        = any_readable_channel_type<Channel> and detail::is_optional<typename Channel::send_type>;
+
+    template <typename Channel, typename In, typename U>
+    concept writable_stream_type
+        = writable_channel_type<Channel, std::optional<U>>
+          and std::same_as<typename Channel::executor_type, typename In::executor_type>;
+
+    // Writes fn(value) for every value of the input, using parallelism workers.
+    // With more than one worker, results are written in the order they complete.
+    template <readable_stream_type In, typename Out, typename Fn>
+    requires std::invocable<Fn&, detail::stream_value_t<In>>
+             and writable_stream_type<Out, In, std::invoke_result_t<Fn&, detail::stream_value_t<In>>>
+    [[nodiscard]] auto transform(In in, Out out, Fn fn, std::size_t const parallelism = 1)
+        -> asio::awaitable<void, typename In::executor_type>
+    // clang-format on
+    {
+        using value_type = detail::stream_value_t<In>;
+        using result_type = std::invoke_result_t<Fn&, value_type>;
+
+        return detail::run_stage<result_type>(
+            std::move(in),
+            std::move(out),
+            [fn = std::move(fn)](value_type&& value) mutable -> std::optional<result_type>
+            {
+                return std::invoke(fn, std::move(value));
+            },
+            parallelism,
+            false);
+    }
+
+    // Like transform, but results are written in the order of the input.
+    // clang-format off
+    template <readable_stream_type In, typename Out, typename Fn>
+    requires std::invocable<Fn&, detail::stream_value_t<In>>
+             and writable_stream_type<Out, In, std::invoke_result_t<Fn&, detail::stream_value_t<In>>>
+    [[nodiscard]] auto ordered_parallel_map(In in, Out out, Fn fn, std::size_t const parallelism)
+        -> asio::awaitable<void, typename In::executor_type>
+    // clang-format on
+    {
+        using value_type = detail::stream_value_t<In>;
+        using result_type = std::invoke_result_t<Fn&, value_type>;
+
+        return detail::run_stage<result_type>(
+            std::move(in),
+            std::move(out),
+            [fn = std::move(fn)](value_type&& value) mutable -> std::optional<result_type>
+            {
+                return std::invoke(fn, std::move(value));
+            },
+            parallelism,
+            true);
+    }
+
+    // Writes the values of the input for which pred returns true.
+    // clang-format off
+    template <readable_stream_type In, typename Out, typename Pred>
+    requires std::predicate<Pred&, detail::stream_value_t<In> const&>
+             and writable_stream_type<Out, In, detail::stream_value_t<In>>
+    [[nodiscard]] auto filter(In in, Out out, Pred pred, std::size_t const parallelism = 1)
+        -> asio::awaitable<void, typename In::executor_type>
+    // clang-format on
+    {
+        using value_type = detail::stream_value_t<In>;
+
+        return detail::run_stage<value_type>(
+            std::move(in),
+            std::move(out),
+            [pred = std::move(pred)](value_type&& value) mutable -> std::optional<value_type>
+            {
+                if (std::invoke(pred, std::as_const(value)))
+                {
+                    return std::move(value);
+                }
+
+                return std::nullopt;
+            },
+            parallelism,
+            false);
+    }
+
+    // Writes the values of the input in vectors of up to max_size values.
+    // A partial batch is written once max_delay has passed since its first value.
+    // clang-format off
+    template <readable_stream_type In, typename Out, typename Rep, typename Period>
+    requires writable_stream_type<Out, In, std::vector<detail::stream_value_t<In>>>
+    [[nodiscard]] auto batch(
+        In in,
+        Out out,
+        std::size_t const max_size,
+        std::chrono::duration<Rep, Period> const max_delay)
+        -> asio::awaitable<void, typename In::executor_type>
+    // clang-format on
+    {
+        using executor_type = typename In::executor_type;
+        using value_type = detail::stream_value_t<In>;
+        using wheel_type = basic_timer_wheel<executor_type>;
+        using clock_type = typename wheel_type::clock_type;
+        using duration = typename wheel_type::duration;
+
+        assert(max_size > 0);
+
+        // A single timeout is pending at a time, so a small wheel is enough.
+        auto const delay = std::chrono::duration_cast<duration>(max_delay);
+        auto const tick = std::max(delay / 8, duration{std::chrono::microseconds{1}});
+        auto wheel = wheel_type{co_await asio::this_coro::executor, tick, 16};
+
+        auto values = std::vector<value_type>{};
+        auto deadline = typename clock_type::time_point{};
+
+        auto const flush = [&]()
+        {
+            return detail::write_stream(out, std::exchange(values, {}));
+        };
+
+        while (true)
+        {
+            auto value = std::optional<value_type>{};
+            if (values.empty())
+            {
+                value = co_await in.read();
+                deadline = clock_type::now() + delay;
+            }
+            else
+            {
+                auto result = co_await select(
+                    ops::read(in),
+                    ops::timeout(wheel, deadline - clock_type::now()));
+                if (result.timed_out())
+                {
+                    co_await flush();
+                    continue;
+                }
+                value = std::move(result).template get_received<std::optional<value_type>>();
+            }
+
+            if (not value)
+            {
+                break;
+            }
+
+            values.push_back(std::move(*value));
+            if (values.size() == max_size)
+            {
+                co_await flush();
+            }
+        }
+
+        if (not values.empty())
+        {
+            co_await flush();
+        }
+
+        co_await detail::write_stream(out, std::nullopt);
+    }
+}  // namespace asiochan
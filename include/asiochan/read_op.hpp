@@ -1,14 +1,17 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <utility>
 
 #include "asiochan/asio.hpp"
 #include "asiochan/channel_concepts.hpp"
+#include "asiochan/channel_stats.hpp"
 #include "asiochan/detail/channel_op_result_base.hpp"
 #include "asiochan/detail/channel_waiter_list.hpp"
 #include "asiochan/detail/send_slot.hpp"
@@ -31,6 +34,13 @@ namespace asiochan
         {
         }
 
+        template <std::convertible_to<T> U>
+        read_result(U&& value, void* const shared_state)
+          : base{shared_state}
+          , value_{std::forward<U>(value)}
+        {
+        }
+
         [[nodiscard]] auto get() & noexcept -> T&
         {
             return value_;
@@ -67,6 +77,163 @@ namespace asiochan
         static void get() noexcept { }
     };
 
+    namespace detail
+    {
+        // Takes a value from the buffer, or from a waiting writer.
+        template <typename ChannelState, sendable T>
+        [[nodiscard]] auto read_if_ready(ChannelState& channel_state, send_slot<T>& slot) -> bool
+        {
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            if constexpr (ChannelState::buff_size != 0)
+            {
+                if (not channel_state.buffer().empty())
+                {
+                    // Get a value from the buffer.
+                    channel_state.buffer().dequeue(slot);
+                    channel_state.trace_read_dequeued();
+                    channel_state.stats().record_waitfree(channel_op_kind::read);
+
+                    if constexpr (not ChannelState::write_never_waits)
+                    {
+                        // Slots held by read loans are only freed once released.
+                        auto const writer = channel_state.buffer().full()
+                                                ? nullptr
+                                                : channel_state.writer_list().dequeue_first_available();
+                        if (writer)
+                        {
+                            // Buffer was full with writers waiting.
+                            // Wake the oldest writer and store his value in the buffer.
+                            channel_state.buffer().enqueue(*writer->slot);
+                            channel_state.trace_buffer_enqueued(*writer);
+                            channel_state.trace_waiter_woken(channel_op_kind::write);
+                            notify_waiter(*writer);
+                        }
+                    }
+
+                    return true;
+                }
+            }
+            else if (auto const writer = channel_state.writer_list().dequeue_first_available())
+            {
+                // Get a value directly from a waiting writer.
+                transfer(*writer->slot, slot);
+                channel_state.trace_write_enqueued(*writer);
+                channel_state.trace_read_dequeued();
+                channel_state.trace_waiter_woken(channel_op_kind::write);
+                notify_waiter(*writer);
+                channel_state.stats().record_waitfree(channel_op_kind::read);
+
+                return true;
+            }
+
+            return false;
+        }
+
+        // Like read_if_ready, but parks a reader in the channel when no value is available.
+        template <typename ChannelState, sendable T, asio::execution::executor Executor, typename WaiterNode>
+        [[nodiscard]] auto read_or_wait(
+            ChannelState& channel_state,
+            select_wait_context<Executor>& select_ctx,
+            select_waiter_token const token,
+            send_slot<T>& slot,
+            std::optional<WaiterNode>& waiter_node_storage)
+            -> channel_submit_result
+        {
+            static_assert(std::derived_from<WaiterNode, typename ChannelState::waiter_node_type>,
+                          "The waiter node must be able to hold the stamp of the channel");
+
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            if constexpr (ChannelState::buff_size != 0)
+            {
+                if (not channel_state.buffer().empty())
+                {
+                    if (not claim(select_ctx))
+                    {
+                        return channel_submit_result::claimed_elsewhere;
+                    }
+
+                    // Get a value from the buffer.
+                    channel_state.buffer().dequeue(slot);
+                    channel_state.trace_read_dequeued();
+
+                    if constexpr (not ChannelState::write_never_waits)
+                    {
+                        // Slots held by read loans are only freed once released.
+                        auto const writer = channel_state.buffer().full()
+                                                ? nullptr
+                                                : channel_state.writer_list().dequeue_first_available();
+                        if (writer)
+                        {
+                            // Buffer was full with writers waiting.
+                            // Wake the oldest writer and store his value in the buffer.
+                            channel_state.buffer().enqueue(*writer->slot);
+                            channel_state.trace_buffer_enqueued(*writer);
+                            channel_state.trace_waiter_woken(channel_op_kind::write);
+                            notify_waiter(*writer);
+                        }
+                    }
+
+                    channel_state.stats().record_waitfree(channel_op_kind::read);
+
+                    return channel_submit_result::ready;
+                }
+            }
+            else if (auto const writer = channel_state.writer_list().dequeue_first_available(select_ctx))
+            {
+                // Get a value directly from a waiting writer.
+                transfer(*writer->slot, slot);
+                channel_state.trace_write_enqueued(*writer);
+                channel_state.trace_read_dequeued();
+                channel_state.trace_waiter_woken(channel_op_kind::write);
+                notify_waiter(*writer);
+                channel_state.stats().record_waitfree(channel_op_kind::read);
+
+                return channel_submit_result::ready;
+            }
+
+            // Wait for a value.
+            auto& waiter_node = waiter_node_storage.emplace();
+            waiter_node.ctx = &select_ctx;
+            waiter_node.slot = &slot;
+            waiter_node.token = token;
+            waiter_node.next = nullptr;
+            if constexpr (ChannelState::stamps_waiters)
+            {
+                waiter_node.parked_at = std::chrono::steady_clock::now();
+            }
+
+            channel_state.reader_list().enqueue(waiter_node);
+            channel_state.trace_waiter_parked(channel_op_kind::read, waiter_node);
+
+            return channel_submit_result::waiting;
+        }
+
+        template <typename ChannelState, typename WaiterNode, typename WaitStamp>
+        void clear_read_wait(
+            ChannelState& channel_state,
+            std::optional<WaiterNode>& waiter_node,
+            bool const successful,
+            WaitStamp const& wait_stamp)
+        {
+            if (not waiter_node.has_value())
+            {
+                // No need to clear wait on an unsubmitted sub-operation
+                return;
+            }
+
+            if (successful)
+            {
+                channel_state.stats().record_wakeup(channel_op_kind::read, wait_stamp.elapsed());
+                return;
+            }
+
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+            channel_state.reader_list().dequeue(*waiter_node);
+        }
+    }  // namespace detail
+
     namespace ops
     {
         template <sendable T, readable_channel_type<T> ChannelsHead, readable_channel_type<T>... ChannelsTail>
@@ -76,14 +243,23 @@ namespace asiochan
             using executor_type = typename ChannelsHead::executor_type;
             using result_type = read_result<T>;
             using slot_type = detail::send_slot<T>;
-            using waiter_node_type = detail::channel_waiter_list_node<T, executor_type>;
-
+            static constexpr bool any_stamps_waiters = ChannelsHead::shared_state_type::stamps_waiters
+                                                    or (ChannelsTail::shared_state_type::stamps_waiters or ...);
+            using waiter_node_type = detail::channel_waiter_node_t<T, executor_type, any_stamps_waiters>;
+
+            static constexpr bool executor_affine = ChannelsHead::shared_state_type::single_threaded
+                                                 and (ChannelsTail::shared_state_type::single_threaded and ...);
+            static constexpr bool batch_wakeups = ChannelsHead::shared_state_type::batch_wakeups
+                                               or (ChannelsTail::shared_state_type::batch_wakeups or ...);
+            static constexpr bool any_stats_enabled = ChannelsHead::shared_state_type::stats_enabled
+                                                   or (ChannelsTail::shared_state_type::stats_enabled or ...);
             static constexpr auto num_alternatives = 1u + sizeof...(ChannelsTail);
             static constexpr auto always_waitfree = false;
 
             struct wait_state_type
             {
                 std::array<std::optional<waiter_node_type>, num_alternatives> waiter_nodes = {};
+                [[no_unique_address]] detail::channel_wait_stamp<any_stats_enabled> wait_stamp = {};
             };
 
             explicit read(ChannelsHead& channels_head, ChannelsTail&... channels_tail) noexcept
@@ -97,45 +273,18 @@ namespace asiochan
 
                 ([&]<std::size_t... indices>(std::index_sequence<indices...>)
                  {
-                     ([&]<typename ChannelState>(ChannelState& channel_state)
+                     ([&]()
                       {
                           constexpr auto channel_index = indices;
-                          auto const lock = std::scoped_lock{channel_state.mutex()};
 
-                          if constexpr (ChannelState::buff_size != 0)
+                          if (detail::read_if_ready(std::get<channel_index>(channels_).shared_state(), slot_))
                           {
-                              if (not channel_state.buffer().empty())
-                              {
-                                  // Get a value from the buffer.
-                                  channel_state.buffer().dequeue(slot_);
-                                  ready_alternative = channel_index;
-
-                                  if constexpr (not ChannelState::write_never_waits)
-                                  {
-                                      if (auto const writer = channel_state.writer_list().dequeue_first_available())
-                                      {
-                                          // Buffer was full with writers waiting.
-                                          // Wake the oldest writer and store his value in the buffer.
-                                          channel_state.buffer().enqueue(*writer->slot);
-                                          detail::notify_waiter(*writer);
-                                      }
-                                  }
-
-                                  return true;
-                              }
-                          }
-                          else if (auto const writer = channel_state.writer_list().dequeue_first_available())
-                          {
-                              // Get a value directly from a waiting writer.
-                              transfer(*writer->slot, slot_);
-                              detail::notify_waiter(*writer);
                               ready_alternative = channel_index;
-
                               return true;
                           }
 
                           return false;
-                      }(std::get<indices>(channels_).shared_state())
+                      }()
                       or ...);
                  }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
 
@@ -148,92 +297,50 @@ namespace asiochan
                 wait_state_type& wait_state)
                 -> std::optional<std::size_t>
             {
-                return ([&]<std::size_t... indices>(std::index_sequence<indices...>)
-                        {
-                            auto ready_alternative = std::optional<std::size_t>{};
-
-                            ([&]<typename ChannelState>(ChannelState& channel_state)
-                             {
-                                 constexpr auto channel_index = indices;
-                                 auto const token = base_token + channel_index;
-                                 auto const lock = std::scoped_lock{channel_state.mutex()};
-
-                                 if constexpr (ChannelState::buff_size != 0)
-                                 {
-                                     if (not channel_state.buffer().empty())
-                                     {
-                                         if (not claim(select_ctx))
-                                         {
-                                             // A different waiting operation succeeded concurrently
-                                             return true;
-                                         }
-
-                                         // Get a value from the buffer.
-                                         channel_state.buffer().dequeue(slot_);
-
-                                         if constexpr (not ChannelState::write_never_waits)
-                                         {
-                                             if (auto const writer = channel_state.writer_list().dequeue_first_available())
-                                             {
-                                                 // Buffer was full with writers waiting.
-                                                 // Wake the oldest writer and store his value in the buffer.
-                                                 channel_state.buffer().enqueue(*writer->slot);
-                                                 detail::notify_waiter(*writer);
-                                             }
-                                         }
-
-                                         ready_alternative = channel_index;
-
-                                         return true;
-                                     }
-                                 }
-                                 else if (auto const writer = channel_state.writer_list().dequeue_first_available(select_ctx))
-                                 {
-                                     // Get a value directly from a waiting writer.
-                                     transfer(*writer->slot, slot_);
-                                     detail::notify_waiter(*writer);
-                                     ready_alternative = channel_index;
-
-                                     return true;
-                                 }
-
-                                 // Wait for a value.
-                                 auto& waiter_node = wait_state.waiter_nodes[channel_index].emplace();
-                                 waiter_node.ctx = &select_ctx;
-                                 waiter_node.slot = &slot_;
-                                 waiter_node.token = token;
-                                 waiter_node.next = nullptr;
-
-                                 channel_state.reader_list().enqueue(waiter_node);
-
-                                 return false;
-                             }(std::get<indices>(channels_).shared_state())
-                             or ...);
-
-                            return ready_alternative;
-                        }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
-            }
+                auto ready_alternative = std::optional<std::size_t>{};
 
-            void clear_wait(
-                std::optional<std::size_t> const successful_alternative,
-                wait_state_type& wait_state)
-            {
                 ([&]<std::size_t... indices>(std::index_sequence<indices...>)
                  {
-                     ([&](auto& channel_state)
+                     ([&]()
                       {
                           constexpr auto channel_index = indices;
-                          auto& waiter_node = wait_state.waiter_nodes[channel_index];
 
-                          if (channel_index == successful_alternative or not waiter_node.has_value())
+                          switch (detail::read_or_wait(
+                              std::get<channel_index>(channels_).shared_state(),
+                              select_ctx,
+                              base_token + channel_index,
+                              slot_,
+                              wait_state.waiter_nodes[channel_index]))
                           {
-                              // No need to clear wait on a successful or unsubmitted sub-operation
-                              return;
+                          case detail::channel_submit_result::ready:
+                              ready_alternative = channel_index;
+                              return true;
+                          case detail::channel_submit_result::waiting:
+                              wait_state.wait_stamp.start();
+                              return false;
+                          case detail::channel_submit_result::claimed_elsewhere:
+                              break;
                           }
 
-                          auto const lock = std::scoped_lock{channel_state.mutex()};
-                          channel_state.reader_list().dequeue(*waiter_node);
-                      }(std::get<indices>(channels_).shared_state()),
+                          return true;
+                      }()
+                      or ...);
+                 }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
+
+                return ready_alternative;
+            }
+
+            void clear_wait(
+                std::optional<std::size_t> const successful_alternative,
+                wait_state_type& wait_state)
+            {
+                ([&]<std::size_t... indices>(std::index_sequence<indices...>)
+                 {
+                     (detail::clear_read_wait(
+                          std::get<indices>(channels_).shared_state(),
+                          wait_state.waiter_nodes[indices],
+                          indices == successful_alternative,
+                          wait_state.wait_stamp),
                       ...);
                  }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
             }
@@ -3,6 +3,7 @@
 #include <array>
 #include <cstddef>
 #include <exception>
+#include <functional>
 #include <mutex>
 #include <optional>
 #include <stdexcept>
@@ -10,17 +11,108 @@
 #include <type_traits>
 #include <utility>
 
+#include "asiochan/adaptive_spin.hpp"
 #include "asiochan/asio.hpp"
 #include "asiochan/async_promise.hpp"
+#include "asiochan/detail/async_select_operation.hpp"
 #include "asiochan/detail/channel_shared_state.hpp"
 #include "asiochan/detail/channel_waiter_list.hpp"
 #include "asiochan/detail/select_impl.hpp"
 #include "asiochan/detail/send_slot.hpp"
 #include "asiochan/select_concepts.hpp"
 #include "asiochan/select_result.hpp"
+#include "asiochan/single_threaded_mutex.hpp"
 
 namespace asiochan
 {
+    namespace detail
+    {
+        // Consecutive selects of a thread that may complete without suspending,
+        // before one is resumed through the executor so that other work can run.
+        inline constexpr auto max_inline_completions = std::size_t{64};
+
+        [[nodiscard]] inline auto inline_completions() noexcept -> std::size_t&
+        {
+            thread_local auto count = std::size_t{0};
+            return count;
+        }
+
+        // Selects, and returns the transformed result, from a single coroutine frame.
+        template <typename Result, asio::execution::executor Executor, typename Transform, select_op... Ops>
+        auto select_transformed(Transform transform, Ops... ops_args) -> asio::awaitable<Result, Executor>
+        {
+            if (inline_completions() >= max_inline_completions)
+            {
+                inline_completions() = 0;
+                co_await asio::post(co_await asio::this_coro::executor, asio::use_awaitable_t<Executor>{});
+            }
+
+            // Ready operations complete without suspending, and without posting the completion.
+            if (auto ready_result = select_try_ready(ops_args...))
+            {
+                ++inline_completions();
+                co_return std::invoke(std::move(transform), std::move(*ready_result));
+            }
+
+            inline_completions() = 0;
+
+            using submit_mutex_type = std::conditional_t<
+                select_executor_affine<Ops...>,
+                single_threaded_mutex,
+                std::mutex>;
+
+            auto submit_mutex = submit_mutex_type{};
+            auto wait_ctx = select_promise_wait_context_for<Executor, Ops...>{};
+            auto ops_wait_states = select_wait_states<Ops...>{};
+
+            // Awaits the promise of the wait context directly, without the frame of suspend_with_promise.
+            auto const success_token = co_await wait_ctx.promise.get_awaitable(
+                [](auto* const submit_mutex,
+                   auto* const wait_ctx,
+                   auto* const ops_wait_states,
+                   auto* const... ops_args)
+                {
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+                    // Connect before submitting, once submitted the promise may complete concurrently.
+                    connect_cancellation(*wait_ctx, wait_ctx->promise.get_cancellation_slot());
+#endif
+
+                    auto ready_token = std::optional<select_waiter_token>{};
+
+                    {
+                        auto const submit_lock = std::scoped_lock{*submit_mutex};
+                        ready_token = select_submit_with_wait(*wait_ctx, *ops_wait_states, *ops_args...);
+                    }
+
+                    if (ready_token)
+                    {
+                        complete(*wait_ctx, *ready_token);
+                    }
+                },
+                &submit_mutex,
+                &wait_ctx,
+                &ops_wait_states,
+                &ops_args...);
+
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+            disconnect_cancellation(wait_ctx);
+#endif
+
+            auto const submit_lock = std::scoped_lock{submit_mutex};
+            auto result = select_clear_wait(success_token, ops_wait_states, ops_args...);
+
+            if (success_token == select_cancelled_token)
+            {
+                // All waits were cleared above, as no operation matches the token.
+                throw system::system_error{system::error_code{asio::error::operation_aborted}};
+            }
+
+            assert(result.has_value());
+
+            co_return std::invoke(std::move(transform), std::move(*result));
+        }
+    }  // namespace detail
+
     // clang-format off
     template <select_op... Ops,
               asio::execution::executor Executor = typename detail::head_t<Ops...>::executor_type>
@@ -29,84 +121,78 @@ namespace asiochan
         -> asio::awaitable<select_result<Ops...>, Executor>
     // clang-format on
     {
-        auto result = std::optional<select_result<Ops...>>{};
-        auto submit_mutex = std::mutex{};
-        auto wait_ctx = detail::select_wait_context<Executor>{};
-        auto ops_wait_states = std::tuple<typename Ops::wait_state_type...>{};
-
-        auto const success_token = co_await suspend_with_promise<detail::select_waiter_token, Executor>(
-            [](async_promise<detail::select_waiter_token, Executor>&& promise,
-               auto* const submit_mutex,
-               auto* const wait_ctx,
-               auto* const ops_wait_states,
-               auto* const... ops_args)
+        return detail::select_transformed<select_result<Ops...>, Executor>(std::identity{}, std::move(ops_args)...);
+    }
+
+    // clang-format off
+    template <select_op... Ops,
+              asio::execution::executor Executor = typename detail::head_t<Ops...>::executor_type>
+    requires waitable_selection<Ops...>
+    [[nodiscard]] auto select(adaptive_spin& spin, Ops... ops_args)
+        -> asio::awaitable<select_result<Ops...>, Executor>
+    // clang-format on
+    {
+        auto wait = adaptive_spin::parked_wait{};
+        if (detail::inline_completions() < detail::max_inline_completions)
+        {
+            auto result = spin.spin(
+                [&]()
+                {
+                    return detail::select_try_ready(ops_args...);
+                },
+                wait);
+
+            if (result)
             {
-                wait_ctx->promise = std::move(promise);
+                ++detail::inline_completions();
+                co_return std::move(*result);
+            }
+        }
 
-                auto ready_token = std::optional<std::size_t>{};
+        auto result = co_await select(std::move(ops_args)...);
+        wait.woken();
 
-                {
-                    auto const submit_lock = std::scoped_lock{*submit_mutex};
-
-                    ([&]<std::size_t... indices>(std::index_sequence<indices...>)
-                     {
-                         ([&]<std::size_t channel_index>(auto& op, detail::constant<channel_index>)
-                          {
-                              constexpr auto op_base_token = detail::select_ops_base_tokens<Ops...>[channel_index];
-
-                              if (auto const ready_alternative = op.submit_with_wait(
-                                      *wait_ctx,
-                                      op_base_token,
-                                      std::get<channel_index>(*ops_wait_states)))
-                              {
-                                  ready_token = op_base_token + *ready_alternative;
-
-                                  return true;
-                              }
-
-                              return false;
-                          }(*ops_args, detail::constant<indices>{})
-                          or ...);
-                     }(std::index_sequence_for<Ops...>{}));
-                }
-
-                if (ready_token)
-                {
-                    wait_ctx->promise.set_value(*ready_token);
-                }
+        co_return result;
+    }
+
+    // clang-format off
+    template <typename CompletionToken, select_op... Ops>
+    requires waitable_selection<Ops...>
+    auto async_select(CompletionToken&& token, Ops... ops_args)
+    // clang-format on
+    {
+        return asio::async_initiate<CompletionToken, void(select_result<Ops...>)>(
+            [](auto&& handler, Ops... ops_args)
+            {
+                detail::start_async_select<detail::select_result_completion>(
+                    std::forward<decltype(handler)>(handler),
+                    std::tuple{},
+                    [&](std::tuple<>&)
+                    {
+                        return std::tuple<Ops...>{std::move(ops_args)...};
+                    });
             },
-            &submit_mutex,
-            &wait_ctx,
-            &ops_wait_states,
-            &ops_args...);
-
-        auto const submit_lock = std::scoped_lock{submit_mutex};
-
-        ([&]<std::size_t... indices>(std::index_sequence<indices...>)
-         {
-             ([&]<select_op Op, std::size_t channel_index>(Op& op, detail::constant<channel_index>)
-              {
-                  constexpr auto op_base_token = detail::select_ops_base_tokens<Ops...>[channel_index];
-
-                  auto successful_alternative = std::optional<std::size_t>{};
-
-                  if (success_token >= op_base_token
-                      and success_token < op_base_token + Op::num_alternatives)
-                  {
-                      successful_alternative = success_token - op_base_token;
-                      result.emplace(op.get_result(*successful_alternative), success_token);
-                  }
-
-                  op.clear_wait(
-                      successful_alternative,
-                      std::get<channel_index>(ops_wait_states));
-              }(ops_args, detail::constant<indices>{}),
-              ...);
-         }(std::index_sequence_for<Ops...>{}));
+            token,
+            std::move(ops_args)...);
+    }
+
+    // clang-format off
+    template <select_op... Ops,
+              asio::execution::executor Executor = typename detail::head_t<Ops...>::executor_type>
+    requires waitable_selection<Ops...>
+    [[nodiscard]] auto blocking_select(Ops... ops_args) -> select_result<Ops...>
+    // clang-format on
+    {
+        auto wait_ctx = detail::select_blocking_wait_context<Executor>{};
+        auto ops_wait_states = detail::select_wait_states<Ops...>{};
+
+        auto const ready_token = detail::select_submit_with_wait(wait_ctx, ops_wait_states, ops_args...);
+        auto const success_token = ready_token ? *ready_token : wait_ctx.wait();
 
+        auto result = detail::select_clear_wait(success_token, ops_wait_states, ops_args...);
         assert(result.has_value());
 
-        co_return std::move(*result);
+        return std::move(*result);
     }
 
     // clang-format off
@@ -115,28 +201,7 @@ namespace asiochan
     auto select_ready(Ops... ops_args) -> select_result<Ops...>
     // clang-format on
     {
-        auto result = std::optional<select_result<Ops...>>{};
-
-        ([&]<std::size_t... indices>(std::index_sequence<indices...>)
-         {
-             ([&]<std::size_t channel_index>(auto& op, detail::constant<channel_index>)
-              {
-                  constexpr auto op_base_token = detail::select_ops_base_tokens<Ops...>[channel_index];
-
-                  if (auto const ready_alternative = op.submit_if_ready())
-                  {
-                      result.emplace(
-                          op.get_result(*ready_alternative),
-                          op_base_token + *ready_alternative);
-
-                      return true;
-                  }
-
-                  return false;
-              }(ops_args, detail::constant<indices>{})
-              or ...);
-         }(std::index_sequence_for<Ops...>{}));
-
+        auto result = detail::select_try_ready(ops_args...);
         assert(result.has_value());
 
         return std::move(*result);
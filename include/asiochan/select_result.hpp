@@ -1,16 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <functional>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
 #include "asiochan/channel_concepts.hpp"
-#include "asiochan/detail/overloaded.hpp"
 #include "asiochan/nothing_op.hpp"
 #include "asiochan/read_op.hpp"
 #include "asiochan/select_concepts.hpp"
+#include "asiochan/timeout_op.hpp"
 #include "asiochan/write_op.hpp"
 
 namespace asiochan
@@ -34,6 +39,8 @@ namespace asiochan
         template <typename T>
         static constexpr bool is_alternative = (std::same_as<T, typename Ops::result_type> or ...);
 
+        static constexpr std::size_t num_alternatives = (Ops::num_alternatives + ...);
+
         template <std::convertible_to<variant_type> T>
         select_result(T&& value, discriminator_type const alternative)
           : result_{std::forward<T>(value)}
@@ -60,6 +67,35 @@ namespace asiochan
             return alternative_;
         }
 
+        // The index of the operation that succeeded, in the order passed to select.
+        [[nodiscard]] auto op_index() const noexcept -> std::size_t
+        {
+            assert(alternative_ < num_alternatives);
+            assert(op_indices[alternative_] == result_.index());
+
+            return op_indices[alternative_];
+        }
+
+        // Invokes the visitor with the result of the operation that succeeded.
+        // The visitor must return the same type for every result type.
+        template <typename Visitor>
+        auto visit(Visitor&& visitor) & -> decltype(auto)
+        {
+            return visit_from<0>(result_, std::forward<Visitor>(visitor));
+        }
+
+        template <typename Visitor>
+        auto visit(Visitor&& visitor) const& -> decltype(auto)
+        {
+            return visit_from<0>(result_, std::forward<Visitor>(visitor));
+        }
+
+        template <typename Visitor>
+        auto visit(Visitor&& visitor) && -> decltype(auto)
+        {
+            return visit_from<0>(std::move(result_), std::forward<Visitor>(visitor));
+        }
+
         // clang-format off
         template <typename T>
         requires is_alternative<T>
@@ -67,14 +103,19 @@ namespace asiochan
         // clang-format on
         {
             // std::holds_alternative does not support multiple type occurrence
-            return std::visit(
-                detail::overloaded{
-                    [](T const&)
-                    { return true; },
-                    [](auto const&)
-                    { return false; },
-                },
-                result_);
+            constexpr auto matches = []()
+            {
+                auto matches = std::array<bool, num_alternatives>{};
+                for (auto alternative = std::size_t{0}; alternative < num_alternatives; ++alternative)
+                {
+                    matches[alternative] = op_matches<T>[op_indices[alternative]];
+                }
+
+                return matches;
+            }();
+
+            assert(alternative_ < num_alternatives);
+            return matches[alternative_];
         }
 
         // clang-format off
@@ -95,6 +136,14 @@ namespace asiochan
             return is<write_result<T>>();
         }
 
+        // clang-format off
+        [[nodiscard]] auto timed_out() const noexcept -> bool
+        requires is_alternative<timeout_result>
+        // clang-format on
+        {
+            return is<timeout_result>();
+        }
+
         // clang-format off
         [[nodiscard]] auto has_value() const noexcept -> bool
         requires is_alternative<no_result_t>
@@ -118,10 +167,9 @@ namespace asiochan
         [[nodiscard]] auto matches(T const& channel) const noexcept -> bool
         // clang-format on
         {
-            return std::visit(
+            return visit(
                 [&](auto const& result)
-                { return result.matches(channel); },
-                result_);
+                { return result.matches(channel); });
         }
 
         // clang-format off
@@ -130,16 +178,9 @@ namespace asiochan
         [[nodiscard]] auto received_from(T const& channel) const noexcept -> bool
         // clang-format on
         {
-            using SendType = typename T::send_type;
+            auto const result = get_if<read_result<typename T::send_type>>();
 
-            return std::visit(
-                detail::overloaded{
-                    [&](read_result<SendType> const& result)
-                    { return result.matches(channel); },
-                    [](auto const&)
-                    { return false; },
-                },
-                result_);
+            return result and result->matches(channel);
         }
 
         // clang-format off
@@ -148,16 +189,9 @@ namespace asiochan
         [[nodiscard]] auto sent_to(T const& channel) const noexcept -> bool
         // clang-format on
         {
-            using SendType = typename T::send_type;
+            auto const result = get_if<write_result<typename T::send_type>>();
 
-            return std::visit(
-                detail::overloaded{
-                    [&](write_result<SendType> const& result)
-                    { return result.matches(channel); },
-                    [](auto const&)
-                    { return false; },
-                },
-                result_);
+            return result and result->matches(channel);
         }
 
         // clang-format off
@@ -166,12 +200,12 @@ namespace asiochan
         [[nodiscard]] auto get() & -> T&
         // clang-format on
         {
-            return std::visit(
-                detail::overloaded{
-                    [](T& result) -> T& { return result; },
-                    [](auto const&) -> T& { throw bad_select_result_access{}; },
-                },
-                result_);
+            if (auto const ptr = get_if<T>())
+            {
+                return *ptr;
+            }
+
+            throw bad_select_result_access{};
         }
 
         // clang-format off
@@ -180,12 +214,12 @@ namespace asiochan
         [[nodiscard]] auto get() const& -> T const&
         // clang-format on
         {
-            return std::visit(
-                detail::overloaded{
-                    [](T const& result) -> T const& { return result; },
-                    [](auto const&) -> T const& { throw bad_select_result_access{}; },
-                },
-                result_);
+            if (auto const ptr = get_if<T>())
+            {
+                return *ptr;
+            }
+
+            throw bad_select_result_access{};
         }
 
         // clang-format off
@@ -194,12 +228,12 @@ namespace asiochan
         [[nodiscard]] auto get() && -> T&&
         // clang-format on
         {
-            return std::visit(
-                detail::overloaded{
-                    [](T& result) -> T&& { return std::move(result); },
-                    [](auto const&) -> T&& { throw bad_select_result_access{}; },
-                },
-                result_);
+            if (auto const ptr = get_if<T>())
+            {
+                return std::move(*ptr);
+            }
+
+            throw bad_select_result_access{};
         }
 
         // clang-format off
@@ -208,12 +242,12 @@ namespace asiochan
         [[nodiscard]] auto get() const&& -> T const&&
         // clang-format on
         {
-            return std::visit(
-                detail::overloaded{
-                    [](T const& result) -> T const&& { return std::move(result); },
-                    [](auto const&) -> T const&& { throw bad_select_result_access{}; },
-                },
-                result_);
+            if (auto const ptr = get_if<T>())
+            {
+                return std::move(*ptr);
+            }
+
+            throw bad_select_result_access{};
         }
 
         // clang-format off
@@ -258,12 +292,7 @@ namespace asiochan
         [[nodiscard]] auto get_if() noexcept -> T*
         // clang-format on
         {
-            return std::visit(
-                detail::overloaded{
-                    [](T& result) -> T* { return &result; },
-                    [](auto const&) -> T* { return nullptr; },
-                },
-                result_);
+            return std::get_if<alternative_index<T>>(&result_);
         }
 
         // clang-format off
@@ -272,12 +301,7 @@ namespace asiochan
         [[nodiscard]] auto get_if() const noexcept -> T const*
         // clang-format on
         {
-            return std::visit(
-                detail::overloaded{
-                    [](T const& result) -> T const* { return &result; },
-                    [](auto const&) -> T const* { return nullptr; },
-                },
-                result_);
+            return std::get_if<alternative_index<T>>(&result_);
         }
 
         // clang-format off
@@ -339,6 +363,85 @@ namespace asiochan
         }
 
       private:
+        // The index of T in the variant. The variant cannot be constructed if T occurs more than once.
+        template <typename T>
+        static constexpr auto alternative_index = []()
+        {
+            constexpr auto matches = std::array{std::same_as<T, typename Ops::result_type>...};
+            return static_cast<std::size_t>(std::ranges::find(matches, true) - matches.begin());
+        }();
+
+        // Maps each alternative to the operation it belongs to.
+        static constexpr auto op_indices = []()
+        {
+            auto indices = std::array<std::size_t, num_alternatives>{};
+            auto alternative = std::size_t{0};
+            auto op_index = std::size_t{0};
+            ((std::fill_n(indices.begin() + alternative, Ops::num_alternatives, op_index),
+              alternative += Ops::num_alternatives,
+              ++op_index),
+             ...);
+
+            return indices;
+        }();
+
+        template <typename T>
+        static constexpr auto op_matches = std::array{std::same_as<T, typename Ops::result_type>...};
+
+        static constexpr std::size_t visit_block_size = 8;
+
+        // A switch over blocks of operations, which compiles to a jump table.
+        // Cases past the last operation are never taken, and repeat it to keep a single return type.
+        template <std::size_t base, typename Variant, typename Visitor>
+        static auto visit_from(Variant&& result, Visitor&& visitor) -> decltype(auto)
+        {
+            constexpr auto last = sizeof...(Ops) - 1;
+            auto const visit_at = [&]<std::size_t offset>() -> decltype(auto)
+            {
+                constexpr auto index = std::min(base + offset, last);
+                auto const alternative = std::get_if<index>(&result);
+                if constexpr (std::is_lvalue_reference_v<Variant>)
+                {
+                    return std::invoke(std::forward<Visitor>(visitor), *alternative);
+                }
+                else
+                {
+                    return std::invoke(std::forward<Visitor>(visitor), std::move(*alternative));
+                }
+            };
+
+            switch (result.index() - base)
+            {
+            case 0:
+                return visit_at.template operator()<0>();
+            case 1:
+                return visit_at.template operator()<1>();
+            case 2:
+                return visit_at.template operator()<2>();
+            case 3:
+                return visit_at.template operator()<3>();
+            case 4:
+                return visit_at.template operator()<4>();
+            case 5:
+                return visit_at.template operator()<5>();
+            case 6:
+                return visit_at.template operator()<6>();
+            case 7:
+                return visit_at.template operator()<7>();
+            default:
+                if constexpr (base + visit_block_size <= last)
+                {
+                    return visit_from<base + visit_block_size>(
+                        std::forward<Variant>(result),
+                        std::forward<Visitor>(visitor));
+                }
+                else
+                {
+                    return visit_at.template operator()<last - base>();
+                }
+            }
+        }
+
         variant_type result_;
         discriminator_type alternative_;
     };
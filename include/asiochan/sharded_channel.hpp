@@ -0,0 +1,255 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/channel.hpp"
+#include "asiochan/channel_buff_size.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/send_slot.hpp"
+#include "asiochan/read_op.hpp"
+#include "asiochan/select.hpp"
+#include "asiochan/sendable.hpp"
+
+namespace asiochan
+{
+    namespace detail
+    {
+        // Threads are assigned consecutive hints on first use, spreading them evenly over the shards.
+        [[nodiscard]] inline auto this_thread_shard_hint() noexcept -> std::size_t
+        {
+            static constinit auto next_hint = std::atomic<std::size_t>{0};
+            thread_local auto const hint = next_hint.fetch_add(1, std::memory_order_relaxed);
+
+            return hint;
+        }
+
+        template <typename Shard, std::size_t num_shards>
+        struct sharded_channel_state
+        {
+            std::array<Shard, num_shards> shards = {};
+            std::atomic<std::size_t> read_cursor = 0;
+            std::atomic<std::size_t> writer_cursor = 0;
+        };
+    }  // namespace detail
+
+    namespace ops
+    {
+        // Reads from any of the shards of a sharded channel, trying the shards starting at a given one.
+        // Rotating the start between operations keeps busy shards from starving the others in select.
+        template <sendable_value T, typename Shard, std::size_t num_shards>
+        class sharded_read
+        {
+          public:
+            using executor_type = typename Shard::executor_type;
+            using result_type = read_result<T>;
+            using slot_type = detail::send_slot<T>;
+            using waiter_node_type = typename Shard::shared_state_type::waiter_node_type;
+
+            static constexpr auto num_alternatives = num_shards;
+            static constexpr auto always_waitfree = false;
+
+            struct wait_state_type
+            {
+                std::array<std::optional<waiter_node_type>, num_alternatives> waiter_nodes = {};
+                [[no_unique_address]] detail::channel_wait_stamp<Shard::shared_state_type::stats_enabled> wait_stamp = {};
+            };
+
+            sharded_read(std::array<Shard, num_shards>& shards, std::size_t const start) noexcept
+              : shards_{shards}
+              , start_{start % num_shards}
+            {
+            }
+
+            [[nodiscard]] auto submit_if_ready() -> std::optional<std::size_t>
+            {
+                for (auto i = std::size_t{0}; i < num_shards; ++i)
+                {
+                    auto const index = (start_ + i) % num_shards;
+                    if (detail::read_if_ready(shards_[index].shared_state(), slot_))
+                    {
+                        return index;
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            [[nodiscard]] auto submit_with_wait(
+                detail::select_wait_context<executor_type>& select_ctx,
+                detail::select_waiter_token const base_token,
+                wait_state_type& wait_state)
+                -> std::optional<std::size_t>
+            {
+                for (auto i = std::size_t{0}; i < num_shards; ++i)
+                {
+                    auto const index = (start_ + i) % num_shards;
+                    switch (detail::read_or_wait(
+                        shards_[index].shared_state(),
+                        select_ctx,
+                        base_token + index,
+                        slot_,
+                        wait_state.waiter_nodes[index]))
+                    {
+                    case detail::channel_submit_result::ready:
+                        return index;
+                    case detail::channel_submit_result::waiting:
+                        wait_state.wait_stamp.start();
+                        break;
+                    case detail::channel_submit_result::claimed_elsewhere:
+                        return std::nullopt;
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            void clear_wait(
+                std::optional<std::size_t> const successful_alternative,
+                wait_state_type& wait_state)
+            {
+                for (auto index = std::size_t{0}; index < num_shards; ++index)
+                {
+                    detail::clear_read_wait(
+                        shards_[index].shared_state(),
+                        wait_state.waiter_nodes[index],
+                        index == successful_alternative,
+                        wait_state.wait_stamp);
+                }
+            }
+
+            [[nodiscard]] auto get_result(std::size_t const successful_alternative) noexcept -> result_type
+            {
+                return result_type{slot_.read(), shards_[successful_alternative]};
+            }
+
+          private:
+            std::array<Shard, num_shards>& shards_;
+            std::size_t start_;
+            slot_type slot_;
+        };
+    }  // namespace ops
+
+    // clang-format off
+    template <sendable_value T,
+              std::size_t num_shards_,
+              channel_buff_size buff_size,
+              asio::execution::executor Executor>
+    requires (num_shards_ > 0)
+    class basic_sharded_channel
+    // clang-format on
+    {
+      public:
+        using executor_type = Executor;
+        using send_type = T;
+        using shard_type = basic_channel<T, buff_size, Executor>;
+        using write_channel_type = basic_write_channel<T, buff_size, Executor>;
+
+        static constexpr auto num_shards = num_shards_;
+
+        [[nodiscard]] basic_sharded_channel()
+          : state_{std::make_shared<state_type>()}
+        {
+        }
+
+        [[nodiscard]] auto shard(std::size_t const index) const noexcept -> shard_type&
+        {
+            return state_->shards[index];
+        }
+
+        // The shard written to by writes from the calling thread.
+        // A coroutine may resume on another thread, and then writes to another shard.
+        [[nodiscard]] auto local_shard() const noexcept -> shard_type&
+        {
+            return shard(detail::this_thread_shard_hint() % num_shards);
+        }
+
+        // A write channel bound to a single shard, assigned round-robin.
+        // Messages written through it keep their order, regardless of the writing thread.
+        [[nodiscard]] auto writer() const -> write_channel_type
+        {
+            return shard(state_->writer_cursor.fetch_add(1, std::memory_order_relaxed) % num_shards);
+        }
+
+        // A read operation over all shards, for use in select.
+        // Like try_read, every operation starts at a different shard.
+        [[nodiscard]] auto read_op() const noexcept -> ops::sharded_read<T, shard_type, num_shards>
+        {
+            return {state_->shards, state_->read_cursor.fetch_add(1, std::memory_order_relaxed)};
+        }
+
+        [[nodiscard]] auto try_read() -> std::optional<T>
+        {
+            // Start at a different shard on every read, so that no shard is starved.
+            auto const start = state_->read_cursor.fetch_add(1, std::memory_order_relaxed);
+            for (auto i = std::size_t{0}; i < num_shards; ++i)
+            {
+                if (auto value = shard((start + i) % num_shards).try_read())
+                {
+                    return value;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        [[nodiscard]] auto read() -> asio::awaitable<T, Executor>
+        {
+            if (auto value = try_read())
+            {
+                co_return std::move(*value);
+            }
+
+            auto result = co_await select(read_op());
+
+            co_return std::move(result).template get_received<T>();
+        }
+
+        // Writes to the shard of the calling thread.
+        // Messages of one thread keep their order, but a coroutine that resumes on different threads
+        // writes to different shards, and its messages may be reordered. Use writer() to keep their order.
+        // clang-format off
+        [[nodiscard]] auto try_write(T value) -> bool
+        requires (buff_size != unbounded_channel_buff)
+        // clang-format on
+        {
+            return local_shard().try_write(std::move(value));
+        }
+
+        // Same ordering as try_write: only messages written from one thread keep their order.
+        // clang-format off
+        [[nodiscard]] auto write(T value) -> asio::awaitable<void, Executor>
+        requires (buff_size != unbounded_channel_buff)
+        // clang-format on
+        {
+            return local_shard().write(std::move(value));
+        }
+
+        // Same ordering as try_write: only messages written from one thread keep their order.
+        // clang-format off
+        void write(T value)
+        requires (buff_size == unbounded_channel_buff)
+        // clang-format on
+        {
+            local_shard().write(std::move(value));
+        }
+
+        [[nodiscard]] friend auto operator==(
+            basic_sharded_channel const& lhs,
+            basic_sharded_channel const& rhs) noexcept -> bool
+            = default;
+
+      private:
+        using state_type = detail::sharded_channel_state<shard_type, num_shards>;
+
+        std::shared_ptr<state_type> state_;
+    };
+
+    template <sendable_value T, std::size_t num_shards, channel_buff_size buff_size = 0>
+    using sharded_channel = basic_sharded_channel<T, num_shards, buff_size, asio::any_io_executor>;
+}  // namespace asiochan
@@ -0,0 +1,41 @@
+#pragma once
+
+#ifndef NDEBUG
+#include <atomic>
+#include <cassert>
+#endif
+
+namespace asiochan
+{
+    // A mutex that does nothing, for state that is only ever accessed from a single
+    // thread or strand. Debug builds assert that it is never locked concurrently.
+    class single_threaded_mutex
+    {
+      public:
+        void lock() noexcept
+        {
+#ifndef NDEBUG
+            assert(not locked_.exchange(true, std::memory_order_acquire)
+                   and "single threaded channel accessed concurrently");
+#endif
+        }
+
+        [[nodiscard]] auto try_lock() noexcept -> bool
+        {
+            lock();
+            return true;
+        }
+
+        void unlock() noexcept
+        {
+#ifndef NDEBUG
+            locked_.store(false, std::memory_order_release);
+#endif
+        }
+
+      private:
+#ifndef NDEBUG
+        std::atomic<bool> locked_ = false;
+#endif
+    };
+}  // namespace asiochan
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/channel_concepts.hpp"
+#include "asiochan/detail/channel_waiter_list.hpp"
+#include "asiochan/detail/timer_wheel_state.hpp"
+#include "asiochan/timer_wheel.hpp"
+
+namespace asiochan
+{
+    class timeout_result
+    {
+      public:
+        [[nodiscard]] friend auto operator<=>(
+            timeout_result const& lhs,
+            timeout_result const& rhs) noexcept = default;
+
+        [[nodiscard]] static auto matches(any_channel_type auto const&) noexcept -> bool
+        {
+            return false;
+        }
+    };
+
+    namespace detail
+    {
+        template <asio::execution::executor Executor>
+        struct timeout_waiter_node : timer_wheel_node
+        {
+            select_wait_context<Executor>* ctx = nullptr;
+            select_waiter_token token = 0;
+
+            static void expire(timer_wheel_node& base)
+            {
+                auto& node = static_cast<timeout_waiter_node&>(base);
+                if (claim(*node.ctx))
+                {
+                    complete(*node.ctx, node.token);
+                }
+            }
+        };
+    }  // namespace detail
+
+    namespace ops
+    {
+        template <asio::execution::executor Executor>
+        class timeout
+        {
+          public:
+            using executor_type = Executor;
+            using result_type = timeout_result;
+            using duration = typename basic_timer_wheel<Executor>::duration;
+
+            static constexpr auto num_alternatives = std::size_t{1};
+            static constexpr auto always_waitfree = false;
+
+            struct wait_state_type
+            {
+                detail::timeout_waiter_node<Executor> node = {};
+            };
+
+            timeout(basic_timer_wheel<Executor> wheel, duration const dur) noexcept
+              : wheel_{std::move(wheel)}
+              , duration_{dur}
+            {
+            }
+
+            [[nodiscard]] auto submit_if_ready() const noexcept -> std::optional<std::size_t>
+            {
+                if (duration_ <= duration::zero())
+                {
+                    return 0;
+                }
+
+                return std::nullopt;
+            }
+
+            [[nodiscard]] auto submit_with_wait(
+                detail::select_wait_context<executor_type>& select_ctx,
+                detail::select_waiter_token const base_token,
+                wait_state_type& wait_state)
+                -> std::optional<std::size_t>
+            {
+                if (duration_ <= duration::zero())
+                {
+                    if (not claim(select_ctx))
+                    {
+                        // A different waiting operation succeeded concurrently
+                        return std::nullopt;
+                    }
+
+                    return 0;
+                }
+
+                auto& node = wait_state.node;
+                node.on_expire = &detail::timeout_waiter_node<Executor>::expire;
+                node.ctx = &select_ctx;
+                node.token = base_token;
+
+                wheel_.shared_state().schedule(node, duration_);
+
+                return std::nullopt;
+            }
+
+            void clear_wait(
+                std::optional<std::size_t> const successful_alternative,
+                wait_state_type& wait_state)
+            {
+                if (successful_alternative or not wait_state.node.ctx)
+                {
+                    // No need to clear wait on a successful or unsubmitted timeout
+                    return;
+                }
+
+                wheel_.shared_state().cancel(wait_state.node);
+            }
+
+            [[nodiscard]] static auto get_result(
+                [[maybe_unused]] std::size_t const successful_alternative) noexcept
+                -> result_type
+            {
+                return timeout_result{};
+            }
+
+          private:
+            basic_timer_wheel<Executor> wheel_;
+            duration duration_;
+        };
+
+        template <asio::execution::executor Executor, typename Rep, typename Period>
+        timeout(basic_timer_wheel<Executor>, std::chrono::duration<Rep, Period>) -> timeout<Executor>;
+    }  // namespace ops
+}  // namespace asiochan
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/detail/timer_wheel_state.hpp"
+
+namespace asiochan
+{
+    template <asio::execution::executor Executor>
+    class basic_timer_wheel
+    {
+      public:
+        using executor_type = Executor;
+        using shared_state_type = detail::timer_wheel_state<Executor>;
+        using clock_type = typename shared_state_type::clock_type;
+        using duration = typename shared_state_type::duration;
+
+        static constexpr auto default_tick = duration{std::chrono::milliseconds{1}};
+        static constexpr auto default_num_slots = std::size_t{512};
+
+        [[nodiscard]] explicit basic_timer_wheel(
+            Executor const& executor,
+            duration const tick = default_tick,
+            std::size_t const num_slots = default_num_slots)
+          : shared_state_{std::make_shared<shared_state_type>(executor, tick, num_slots)}
+        {
+        }
+
+        [[nodiscard]] auto get_executor() const -> executor_type
+        {
+            return shared_state_->get_executor();
+        }
+
+        [[nodiscard]] auto tick() const noexcept -> duration
+        {
+            return shared_state_->tick();
+        }
+
+        [[nodiscard]] auto num_pending() const -> std::size_t
+        {
+            return shared_state_->num_pending();
+        }
+
+        [[nodiscard]] auto shared_state() noexcept -> shared_state_type&
+        {
+            return *shared_state_;
+        }
+
+        [[nodiscard]] friend auto operator==(
+            basic_timer_wheel const& lhs,
+            basic_timer_wheel const& rhs) noexcept -> bool
+            = default;
+
+      private:
+        std::shared_ptr<shared_state_type> shared_state_;
+    };
+
+    using timer_wheel = basic_timer_wheel<asio::any_io_executor>;
+}  // namespace asiochan
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "asiochan/asio.hpp"
+#include "asiochan/async_promise.hpp"
+#include "asiochan/sendable.hpp"
+
+namespace asiochan
+{
+    namespace detail
+    {
+        template <sendable_value T, asio::execution::executor Executor>
+        class work_queue_state
+        {
+          public:
+            explicit work_queue_state(std::size_t const num_workers)
+              : local_queues_(num_workers)
+            {
+                assert(num_workers > 0);
+            }
+
+            [[nodiscard]] auto num_workers() const noexcept -> std::size_t
+            {
+                return local_queues_.size();
+            }
+
+            [[nodiscard]] auto size() const noexcept -> std::size_t
+            {
+                auto const num_queued = num_queued_.load(std::memory_order_relaxed);
+                return num_queued > 0 ? static_cast<std::size_t>(num_queued) : 0;
+            }
+
+            void push(std::size_t const worker, T value)
+            {
+                {
+                    auto& local = local_queues_[worker];
+                    auto const lock = std::scoped_lock{local.mutex};
+                    local.items.push_back(std::move(value));
+                }
+
+                // Pairs with park(): either the parking worker sees the new item,
+                // or we see the parked worker.
+                num_queued_.fetch_add(1, std::memory_order_seq_cst);
+                if (num_parked_.load(std::memory_order_seq_cst) > 0)
+                {
+                    wake_one();
+                }
+            }
+
+            [[nodiscard]] auto push_cursor() noexcept -> std::size_t
+            {
+                return push_cursor_.fetch_add(1, std::memory_order_relaxed) % num_workers();
+            }
+
+            [[nodiscard]] auto try_pop(std::size_t const worker) -> std::optional<T>
+            {
+                // The own queue is used as a stack for locality, other queues are stolen from in FIFO order.
+                if (auto value = take(worker, true))
+                {
+                    return value;
+                }
+
+                for (auto i = std::size_t{1}; i < num_workers(); ++i)
+                {
+                    if (auto value = take((worker + i) % num_workers(), false))
+                    {
+                        return value;
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            [[nodiscard]] auto park() -> asio::awaitable<void, Executor>
+            {
+                co_await suspend_with_promise<void, Executor>(
+                    [](async_promise<void, Executor>&& promise, work_queue_state* const self)
+                    {
+                        auto const lock = std::scoped_lock{self->park_mutex_};
+                        self->num_parked_.fetch_add(1, std::memory_order_seq_cst);
+
+                        if (self->num_queued_.load(std::memory_order_seq_cst) > 0)
+                        {
+                            // An item arrived since we last looked, retry instead of parking.
+                            self->num_parked_.fetch_sub(1, std::memory_order_relaxed);
+                            promise.set_value();
+                            return;
+                        }
+
+                        self->parked_.push_back(std::move(promise));
+                    },
+                    this);
+            }
+
+          private:
+            // Padded to a cache line, so that workers do not falsely share their queues.
+            struct alignas(64) local_queue
+            {
+                std::mutex mutex;
+                std::deque<T> items;
+            };
+
+            std::vector<local_queue> local_queues_;
+            std::atomic<std::ptrdiff_t> num_queued_ = 0;
+            std::atomic<std::size_t> push_cursor_ = 0;
+            std::mutex park_mutex_;
+            std::atomic<std::size_t> num_parked_ = 0;
+            std::deque<async_promise<void, Executor>> parked_;
+
+            [[nodiscard]] auto take(std::size_t const worker, bool const own) -> std::optional<T>
+            {
+                auto& local = local_queues_[worker];
+                auto const lock = std::scoped_lock{local.mutex};
+                if (local.items.empty())
+                {
+                    return std::nullopt;
+                }
+
+                auto value = std::optional<T>{};
+                if (own)
+                {
+                    value.emplace(std::move(local.items.back()));
+                    local.items.pop_back();
+                }
+                else
+                {
+                    value.emplace(std::move(local.items.front()));
+                    local.items.pop_front();
+                }
+                num_queued_.fetch_sub(1, std::memory_order_relaxed);
+
+                return value;
+            }
+
+            void wake_one()
+            {
+                auto promise = std::optional<async_promise<void, Executor>>{};
+                {
+                    auto const lock = std::scoped_lock{park_mutex_};
+                    if (parked_.empty())
+                    {
+                        return;
+                    }
+
+                    promise.emplace(std::move(parked_.front()));
+                    parked_.pop_front();
+                    num_parked_.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                promise->set_value();
+            }
+        };
+    }  // namespace detail
+
+    template <sendable_value T, asio::execution::executor Executor>
+    class basic_work_queue
+    {
+      public:
+        using executor_type = Executor;
+        using send_type = T;
+
+        [[nodiscard]] explicit basic_work_queue(std::size_t const num_workers)
+          : state_{std::make_shared<state_type>(num_workers)}
+        {
+        }
+
+        [[nodiscard]] auto num_workers() const noexcept -> std::size_t
+        {
+            return state_->num_workers();
+        }
+
+        // Approximate number of queued items.
+        [[nodiscard]] auto size() const noexcept -> std::size_t
+        {
+            return state_->size();
+        }
+
+        // Push to the local queue of a worker, typically from within that worker.
+        void push(std::size_t const worker, T value)
+        {
+            assert(worker < num_workers());
+            state_->push(worker, std::move(value));
+        }
+
+        // Push from outside of the workers, spreading items round-robin.
+        void push(T value)
+        {
+            state_->push(state_->push_cursor(), std::move(value));
+        }
+
+        [[nodiscard]] auto try_pop(std::size_t const worker) -> std::optional<T>
+        {
+            assert(worker < num_workers());
+            return state_->try_pop(worker);
+        }
+
+        // Pop from the local queue of the worker, or steal from another worker.
+        // Parks the worker only when all queues are empty.
+        [[nodiscard]] auto pop(std::size_t const worker) -> asio::awaitable<T, Executor>
+        {
+            assert(worker < num_workers());
+
+            auto const state = state_;
+            while (true)
+            {
+                if (auto value = state->try_pop(worker))
+                {
+                    co_return std::move(*value);
+                }
+
+                co_await state->park();
+            }
+        }
+
+        [[nodiscard]] friend auto operator==(
+            basic_work_queue const& lhs,
+            basic_work_queue const& rhs) noexcept -> bool
+            = default;
+
+      private:
+        using state_type = detail::work_queue_state<T, Executor>;
+
+        std::shared_ptr<state_type> state_;
+    };
+
+    template <sendable_value T>
+    using work_queue = basic_work_queue<T, asio::any_io_executor>;
+}  // namespace asiochan
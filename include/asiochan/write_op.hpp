@@ -1,14 +1,18 @@
 #pragma once
 
 #include <array>
+#include <cassert>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <utility>
 
 #include "asiochan/asio.hpp"
 #include "asiochan/channel_concepts.hpp"
+#include "asiochan/channel_stats.hpp"
 #include "asiochan/detail/channel_op_result_base.hpp"
 #include "asiochan/detail/channel_waiter_list.hpp"
 #include "asiochan/detail/send_slot.hpp"
@@ -27,6 +31,151 @@ namespace asiochan
         using base::base;
     };
 
+    namespace detail
+    {
+        // Hands the value to a waiting reader, or stores it in the buffer.
+        template <typename ChannelState, sendable T>
+        [[nodiscard]] auto write_if_ready(ChannelState& channel_state, send_slot<T>& slot) -> bool
+        {
+            auto const lock = std::scoped_lock{channel_state.mutex()};
+
+            if (auto const reader = channel_state.reader_list().dequeue_first_available())
+            {
+                // Buffer was empty with readers waiting.
+                // Wake the oldest reader and give him a value.
+                transfer(slot, *reader->slot);
+                channel_state.trace_write_enqueued();
+                channel_state.trace_read_dequeued();
+                channel_state.trace_waiter_woken(channel_op_kind::read);
+                notify_waiter(*reader);
+                channel_state.stats().record_waitfree(channel_op_kind::write);
+
+                return true;
+            }
+            else if constexpr (ChannelState::buff_size != 0)
+            {
+                if (not channel_state.buffer().full())
+                {
+                    // Store the value in the buffer.
+                    channel_state.buffer().enqueue(slot);
+                    channel_state.trace_buffer_enqueued();
+                    channel_state.stats().record_buffer_size(channel_state.buffer().count());
+                    channel_state.stats().record_waitfree(channel_op_kind::write);
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Like write_if_ready, but parks a writer in the channel when the value cannot be delivered.
+        template <typename ChannelState, sendable T, asio::execution::executor Executor, typename WaiterNode>
+        [[nodiscard]] auto write_or_wait(
+            ChannelState& channel_state,
+            select_wait_context<Executor>& select_ctx,
+            select_waiter_token const token,
+            send_slot<T>& slot,
+            std::optional<WaiterNode>& waiter_node_storage)
+            -> channel_submit_result
+        {
+            static_assert(std::derived_from<WaiterNode, typename ChannelState::waiter_node_type>,
+                          "The waiter node must be able to hold the stamp of the channel");
+
+            if constexpr (ChannelState::write_never_waits)
+            {
+                // Writes to an unbounded channel always succeed.
+                if (not claim(select_ctx))
+                {
+                    return channel_submit_result::claimed_elsewhere;
+                }
+
+                [[maybe_unused]] auto const written = write_if_ready(channel_state, slot);
+                assert(written);
+
+                return channel_submit_result::ready;
+            }
+            else
+            {
+                auto const lock = std::scoped_lock{channel_state.mutex()};
+
+                if (auto const reader = channel_state.reader_list().dequeue_first_available(select_ctx))
+                {
+                    // Buffer was empty with readers waiting.
+                    // Wake the oldest reader and give him a value.
+                    transfer(slot, *reader->slot);
+                    channel_state.trace_write_enqueued();
+                    channel_state.trace_read_dequeued();
+                    channel_state.trace_waiter_woken(channel_op_kind::read);
+                    notify_waiter(*reader);
+                    channel_state.stats().record_waitfree(channel_op_kind::write);
+
+                    return channel_submit_result::ready;
+                }
+                else if constexpr (ChannelState::buff_size != 0)
+                {
+                    if (not channel_state.buffer().full())
+                    {
+                        if (not claim(select_ctx))
+                        {
+                            return channel_submit_result::claimed_elsewhere;
+                        }
+
+                        // Store the value in the buffer.
+                        channel_state.buffer().enqueue(slot);
+                        channel_state.trace_buffer_enqueued();
+                        channel_state.stats().record_buffer_size(channel_state.buffer().count());
+                        channel_state.stats().record_waitfree(channel_op_kind::write);
+
+                        return channel_submit_result::ready;
+                    }
+                }
+
+                // Wait for a reader.
+                auto& waiter_node = waiter_node_storage.emplace();
+                waiter_node.ctx = &select_ctx;
+                waiter_node.slot = &slot;
+                waiter_node.token = token;
+                waiter_node.next = nullptr;
+                if constexpr (ChannelState::stamps_waiters)
+                {
+                    waiter_node.parked_at = std::chrono::steady_clock::now();
+                }
+
+                channel_state.writer_list().enqueue(waiter_node);
+                channel_state.trace_waiter_parked(channel_op_kind::write, waiter_node);
+
+                return channel_submit_result::waiting;
+            }
+        }
+
+        template <typename ChannelState, typename WaiterNode, typename WaitStamp>
+        void clear_write_wait(
+            ChannelState& channel_state,
+            std::optional<WaiterNode>& waiter_node,
+            bool const successful,
+            WaitStamp const& wait_stamp)
+        {
+            if (not waiter_node.has_value())
+            {
+                // No need to clear wait on an unsubmitted sub-operation
+                return;
+            }
+
+            if (successful)
+            {
+                channel_state.stats().record_wakeup(channel_op_kind::write, wait_stamp.elapsed());
+                return;
+            }
+
+            if constexpr (not ChannelState::write_never_waits)
+            {
+                auto const lock = std::scoped_lock{channel_state.mutex()};
+                channel_state.writer_list().dequeue(*waiter_node);
+            }
+        }
+    }  // namespace detail
+
     namespace ops
     {
         template <sendable T, writable_channel_type<T> ChannelsHead, writable_channel_type<T>... ChannelsTail>
@@ -50,14 +199,23 @@ namespace asiochan
             using executor_type = typename ChannelsHead::executor_type;
             using result_type = write_result<T>;
             using slot_type = detail::send_slot<T>;
-            using waiter_node_type = detail::channel_waiter_list_node<T, executor_type>;
-
+            static constexpr bool any_stamps_waiters = ChannelsHead::shared_state_type::stamps_waiters
+                                                    or (ChannelsTail::shared_state_type::stamps_waiters or ...);
+            using waiter_node_type = detail::channel_waiter_node_t<T, executor_type, any_stamps_waiters>;
+
+            static constexpr bool executor_affine = ChannelsHead::shared_state_type::single_threaded
+                                                 and (ChannelsTail::shared_state_type::single_threaded and ...);
+            static constexpr bool batch_wakeups = ChannelsHead::shared_state_type::batch_wakeups
+                                               or (ChannelsTail::shared_state_type::batch_wakeups or ...);
+            static constexpr bool any_stats_enabled = ChannelsHead::shared_state_type::stats_enabled
+                                                   or (ChannelsTail::shared_state_type::stats_enabled or ...);
             static constexpr auto num_alternatives = sizeof...(ChannelsTail) + 1u;
             static constexpr auto always_waitfree = last_always_waitfree;
 
             struct wait_state_type
             {
                 std::array<std::optional<waiter_node_type>, num_alternatives> waiter_nodes = {};
+                [[no_unique_address]] detail::channel_wait_stamp<any_stats_enabled> wait_stamp = {};
             };
 
             // clang-format off
@@ -84,35 +242,18 @@ namespace asiochan
 
                 ([&]<std::size_t... indices>(std::index_sequence<indices...>)
                  {
-                     ([&]<typename ChannelState>(ChannelState& channel_state)
+                     ([&]()
                       {
                           constexpr auto channel_index = indices;
-                          auto const lock = std::scoped_lock{channel_state.mutex()};
 
-                          if (auto const reader = channel_state.reader_list().dequeue_first_available())
+                          if (detail::write_if_ready(std::get<channel_index>(channels_).shared_state(), slot_))
                           {
-                              // Buffer was empty with readers waiting.
-                              // Wake the oldest reader and give him a value.
-                              transfer(slot_, *reader->slot);
-                              detail::notify_waiter(*reader);
                               ready_alternative = channel_index;
-
                               return true;
                           }
-                          else if constexpr (ChannelState::buff_size != 0)
-                          {
-                              if (not channel_state.buffer().full())
-                              {
-                                  // Store the value in the buffer.
-                                  channel_state.buffer().enqueue(slot_);
-                                  ready_alternative = channel_index;
-
-                                  return true;
-                              }
-                          }
 
                           return false;
-                      }(std::get<indices>(channels_).shared_state())
+                      }()
                       or ...);
                  }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
 
@@ -128,56 +269,37 @@ namespace asiochan
                 requires (not always_waitfree)
             // clang-format on
             {
-                return ([&]<std::size_t... indices>(std::index_sequence<indices...>)
-                        {
-                            auto ready_alternative = std::optional<std::size_t>{};
-
-                            ([&]<typename ChannelState>(ChannelState& channel_state)
-                             {
-                                 constexpr auto channel_index = indices;
-                                 auto const token = base_token + channel_index;
-                                 auto const lock = std::scoped_lock{channel_state.mutex()};
-
-                                 if (auto const reader = channel_state.reader_list().dequeue_first_available(select_ctx))
-                                 {
-                                     // Buffer was empty with readers waiting.
-                                     // Wake the oldest reader and give him a value.
-                                     transfer(slot_, *reader->slot);
-                                     detail::notify_waiter(*reader);
-                                     ready_alternative = channel_index;
-
-                                     return true;
-                                 }
-                                 else if constexpr (ChannelState::buff_size != 0)
-                                 {
-                                     if (not channel_state.buffer().full())
-                                     {
-                                         if (claim(select_ctx))
-                                         {
-                                             // Store the value in the buffer.
-                                             channel_state.buffer().enqueue(slot_);
-                                             ready_alternative = channel_index;
-                                         }
-
-                                         return true;
-                                     }
-                                 }
-
-                                 // Wait for a value.
-                                 auto& waiter_node = wait_state.waiter_nodes[channel_index].emplace();
-                                 waiter_node.ctx = &select_ctx;
-                                 waiter_node.slot = &slot_;
-                                 waiter_node.token = token;
-                                 waiter_node.next = nullptr;
-
-                                 channel_state.writer_list().enqueue(waiter_node);
-
-                                 return false;
-                             }(std::get<indices>(channels_).shared_state())
-                             or ...);
-
-                            return ready_alternative;
-                        }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
+                auto ready_alternative = std::optional<std::size_t>{};
+
+                ([&]<std::size_t... indices>(std::index_sequence<indices...>)
+                 {
+                     ([&]()
+                      {
+                          constexpr auto channel_index = indices;
+
+                          switch (detail::write_or_wait(
+                              std::get<channel_index>(channels_).shared_state(),
+                              select_ctx,
+                              base_token + channel_index,
+                              slot_,
+                              wait_state.waiter_nodes[channel_index]))
+                          {
+                          case detail::channel_submit_result::ready:
+                              ready_alternative = channel_index;
+                              return true;
+                          case detail::channel_submit_result::waiting:
+                              wait_state.wait_stamp.start();
+                              return false;
+                          case detail::channel_submit_result::claimed_elsewhere:
+                              break;
+                          }
+
+                          return true;
+                      }()
+                      or ...);
+                 }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
+
+                return ready_alternative;
             }
 
             // clang-format off
@@ -189,20 +311,11 @@ namespace asiochan
             {
                 ([&]<std::size_t... indices>(std::index_sequence<indices...>)
                  {
-                     ([&](auto& channel_state)
-                      {
-                          constexpr auto channel_index = indices;
-                          auto& waiter_node = wait_state.waiter_nodes[channel_index];
-
-                          if (channel_index == successful_alternative or not waiter_node.has_value())
-                          {
-                              // No need to clear wait on a successful or unsubmitted sub-operation
-                              return;
-                          }
-
-                          auto const lock = std::scoped_lock{channel_state.mutex()};
-                          channel_state.reader_list().dequeue(*waiter_node);
-                      }(std::get<indices>(channels_).shared_state()),
+                     (detail::clear_write_wait(
+                          std::get<indices>(channels_).shared_state(),
+                          wait_state.waiter_nodes[indices],
+                          indices == successful_alternative,
+                          wait_state.wait_stamp),
                       ...);
                  }(std::index_sequence_for<ChannelsHead, ChannelsTail...>{}));
             }
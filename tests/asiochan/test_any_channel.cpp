@@ -0,0 +1,209 @@
+#include <optional>
+
+#include <asiochan/any_channel.hpp>
+#include <asiochan/channel.hpp>
+#include <asiochan/channel_policy.hpp>
+#include <asiochan/nothing_op.hpp>
+#include <asiochan/select.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <asio/io_context.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#endif
+
+namespace asio = asiochan::asio;
+
+namespace
+{
+    // Compiled once, for channels of any buffer size.
+    // A value read while the target is full is kept in pending, and written first by the next call.
+    auto forward_ready(
+        asiochan::any_read_channel<int> from,
+        asiochan::any_write_channel<int> to,
+        std::optional<int>& pending) -> int
+    {
+        auto num_forwarded = 0;
+        while (pending or (pending = from.try_read()))
+        {
+            if (not to.try_write(*pending))
+            {
+                break;
+            }
+            pending.reset();
+            ++num_forwarded;
+        }
+
+        return num_forwarded;
+    }
+}  // namespace
+
+TEST_CASE("Type-erased channels")
+{
+    auto io_context = asio::io_context{1};
+
+    SECTION("Handles to channels of different buffer sizes")
+    {
+        auto source = asiochan::channel<int, 4>{};
+        auto target = asiochan::unbounded_channel<int>{};
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            REQUIRE(source.try_write(i));
+        }
+
+        auto pending = std::optional<int>{};
+        CHECK(forward_ready(source, target, pending) == 4);
+        CHECK(not pending);
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            CHECK(target.try_read() == std::optional{i});
+        }
+
+        auto small_target = asiochan::channel<int, 1>{};
+        REQUIRE(source.try_write(10));
+        REQUIRE(source.try_write(11));
+        CHECK(forward_ready(source, small_target, pending) == 1);
+        CHECK(pending == std::optional{11});
+        CHECK(small_target.try_read() == std::optional{10});
+
+        // The value that did not fit is not lost.
+        CHECK(forward_ready(source, small_target, pending) == 1);
+        CHECK(not pending);
+        CHECK(small_target.try_read() == std::optional{11});
+    }
+
+    SECTION("Handles compare equal when they refer to the same channel")
+    {
+        auto channel = asiochan::channel<int>{};
+        auto other = asiochan::channel<int>{};
+
+        CHECK(asiochan::any_read_channel<int>{channel} == asiochan::any_read_channel<int>{channel});
+        CHECK(asiochan::any_read_channel<int>{channel} != asiochan::any_read_channel<int>{other});
+    }
+
+    SECTION("Reading and writing on an unbuffered channel")
+    {
+        auto channel = asiochan::channel<int>{};
+        auto reader = asiochan::any_read_channel<int>{channel};
+        auto writer = asiochan::any_write_channel<int>{channel};
+        auto received = std::optional<int>{};
+
+        CHECK(not writer.try_write(1));
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                received = co_await reader.read();
+            },
+            asio::detached);
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                co_await writer.write(42);
+            },
+            asio::detached);
+
+        io_context.run();
+        CHECK(received == std::optional{42});
+    }
+
+    SECTION("Waits on instrumented channels are recorded")
+    {
+        auto channel = asiochan::basic_channel<
+            int,
+            0,
+            asio::any_io_executor,
+            asiochan::instrumented_channel_policy>{};
+        auto reader = asiochan::any_read_channel<int>{channel};
+        auto received = std::optional<int>{};
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                received = co_await reader.read();
+            },
+            asio::detached);
+
+        io_context.poll();
+        CHECK(channel.stats().reads.parked == 1);
+
+        REQUIRE(channel.try_write(42));
+        io_context.run();
+        CHECK(received == std::optional{42});
+
+        auto const stats = channel.stats();
+        CHECK(stats.reads.suspended == 1);
+        CHECK(stats.reads.wait_times.total() == 1);
+    }
+
+    SECTION("Selecting over erased and concrete operations")
+    {
+        auto buffered = asiochan::channel<int, 2>{};
+        auto unbuffered = asiochan::channel<int>{};
+        auto erased_buffered = asiochan::any_read_channel<int>{buffered};
+        auto erased_unbuffered = asiochan::any_read_channel<int>{unbuffered};
+        auto unbuffered_other = asiochan::channel<int>{};
+
+        auto const empty = asiochan::select_ready(
+            asiochan::ops::any_read(erased_unbuffered, erased_buffered),
+            asiochan::ops::nothing);
+        CHECK(not empty.has_value());
+
+        auto writer = asiochan::any_write_channel<int>{buffered};
+        REQUIRE(writer.try_write(7));
+
+        auto const result = asiochan::select_ready(
+            asiochan::ops::any_read(erased_unbuffered, erased_buffered),
+            asiochan::ops::nothing);
+        CHECK(result.alternative() == 1);
+        CHECK(result.received_from(buffered));
+        CHECK(not result.received_from(unbuffered));
+        CHECK(result.get_received<int>() == 7);
+
+        auto waited = std::optional<int>{};
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                auto const result = co_await asiochan::select(
+                    asiochan::ops::any_read(erased_unbuffered, erased_buffered),
+                    asiochan::ops::write(0, unbuffered_other));
+                CHECK(result.received_from(unbuffered));
+                waited = result.get_received<int>();
+            },
+            asio::detached);
+
+        io_context.run_one();
+        CHECK(not waited);
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                co_await asiochan::select(asiochan::any_write_channel<int>{unbuffered}.write_op(3));
+            },
+            asio::detached);
+
+        io_context.run();
+        CHECK(waited == std::optional{3});
+
+        // The wait on the buffered channel was cleared.
+        REQUIRE(buffered.try_write(8));
+        CHECK(buffered.try_read() == std::optional{8});
+    }
+}
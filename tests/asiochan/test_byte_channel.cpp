@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <asiochan/byte_channel.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <asio/io_context.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#endif
+
+namespace asio = asiochan::asio;
+
+namespace
+{
+    auto to_string(std::span<asio::const_buffer const> const buffers) -> std::string
+    {
+        auto result = std::string(asio::buffer_size(buffers), '\0');
+        asio::buffer_copy(asio::buffer(result), buffers);
+        return result;
+    }
+}  // namespace
+
+static_assert(asio::is_const_buffer_sequence<std::span<asio::const_buffer const>>::value);
+
+TEST_CASE("Byte channel")
+{
+    auto channel = asiochan::byte_channel{8};
+
+    SECTION("Writes are lent to readers in place")
+    {
+        REQUIRE(channel.try_write(asio::buffer(std::string_view{"abc"})));
+        REQUIRE(channel.try_write(asio::buffer(std::string_view{"de"})));
+        CHECK(channel.size() == 5);
+
+        auto view = channel.try_read_some();
+        REQUIRE(view);
+        CHECK(view->buffers().size() == 1);
+        CHECK(to_string(view->buffers()) == "abcde");
+
+        // Only one reader at a time.
+        CHECK(not channel.try_read_some());
+
+        view->consume(2);
+        CHECK(channel.size() == 3);
+    }
+
+    SECTION("Buffers wrap around the end of the ring")
+    {
+        REQUIRE(channel.try_write(asio::buffer(std::string_view{"abcdef"})));
+        channel.try_read_some()->consume(5);
+
+        auto const gathered = std::array{
+            asio::buffer(std::string_view{"gh"}),
+            asio::buffer(std::string_view{"ijk"}),
+        };
+        REQUIRE(channel.try_write(gathered));
+
+        auto view = channel.try_read_some();
+        REQUIRE(view);
+        CHECK(view->buffers().size() == 2);
+        CHECK(to_string(view->buffers()) == "fghijk");
+    }
+
+    SECTION("Writes that do not fit are not split")
+    {
+        REQUIRE(channel.try_write(asio::buffer(std::string_view{"abcdef"})));
+        CHECK(not channel.try_write(asio::buffer(std::string_view{"ghi"})));
+        CHECK_THROWS_AS(
+            channel.try_write(asio::buffer(std::string_view{"123456789"})),
+            std::length_error);
+    }
+
+    SECTION("Writers wait for space in order")
+    {
+        static constexpr auto payloads = std::array<std::string_view, 4>{"aaaaa", "bb", "ccccccc", "dddd"};
+
+        auto io_context = asio::io_context{1};
+        REQUIRE(channel.try_write(asio::buffer(std::string_view{"01234567"})));
+
+        // Every writer parks against the full ring before the next one is started.
+        auto num_written = 0;
+        for (auto const payload : payloads)
+        {
+            asio::co_spawn(
+                io_context,
+                [channel, payload, &num_written]() mutable -> asio::awaitable<void>
+                {
+                    co_await channel.write(asio::buffer(payload));
+                    ++num_written;
+                },
+                asio::detached);
+            io_context.poll();
+        }
+        CHECK(num_written == 0);
+        CHECK(channel.size() == 8);
+
+        auto expected = std::string{"01234567"};
+        for (auto const payload : payloads)
+        {
+            expected += payload;
+        }
+
+        auto received = std::string{};
+        asio::co_spawn(
+            io_context,
+            [channel, &received, &expected]() mutable -> asio::awaitable<void>
+            {
+                while (received.size() < expected.size())
+                {
+                    auto view = co_await channel.read_some();
+                    received += to_string(view.buffers());
+                }
+            },
+            asio::detached);
+        io_context.run();
+
+        CHECK(num_written == static_cast<int>(payloads.size()));
+        CHECK(received == expected);
+    }
+}
@@ -1,30 +1,64 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <ranges>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <asiochan/channel.hpp>
+#include <asiochan/channel_policy.hpp>
+#include <asiochan/channel_registry.hpp>
+#include <asiochan/channel_trace.hpp>
+#include <asiochan/lock_profile.hpp>
+#include <asiochan/nothing_op.hpp>
+#include <asiochan/select.hpp>
 #include <catch2/catch.hpp>
 
 #ifdef ASIOCHAN_USE_STANDALONE_ASIO
 
+#include <asio/bind_executor.hpp>
 #include <asio/co_spawn.hpp>
 #include <asio/detached.hpp>
 #include <asio/io_context.hpp>
 #include <asio/thread_pool.hpp>
 #include <asio/use_future.hpp>
 
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+#include <asio/bind_cancellation_slot.hpp>
+#include <asio/cancellation_signal.hpp>
+#include <asio/experimental/awaitable_operators.hpp>
+#endif
+
 #else
 
+#include <boost/asio/bind_executor.hpp>
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/asio/use_future.hpp>
 
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/experimental/awaitable_operators.hpp>
+#endif
+
 #endif
 
 namespace asio = asiochan::asio;
 
+using namespace std::literals;
+
 TEST_CASE("Channels")
 {
     auto const num_threads = GENERATE(range(1u, 2u));
@@ -192,3 +226,1700 @@ TEST_CASE("Channels")
         }
     }
 }
+
+TEST_CASE("Completion tokens")
+{
+    SECTION("Callbacks")
+    {
+        auto io_context = asio::io_context{};
+        auto channel = asiochan::channel<std::string>{};
+        auto received = std::string{};
+        auto sent = false;
+
+        channel.async_read(
+            asio::bind_executor(
+                io_context,
+                [&](std::string value)
+                {
+                    received = std::move(value);
+                }));
+        channel.async_write(
+            "hello",
+            asio::bind_executor(
+                io_context,
+                [&]()
+                {
+                    sent = true;
+                }));
+
+        io_context.run();
+
+        CHECK(received == "hello");
+        CHECK(sent);
+    }
+
+    SECTION("Futures")
+    {
+        auto thread_pool = asio::thread_pool{1};
+        auto channel = asiochan::channel<int, 1>{};
+        auto void_channel = asiochan::channel<void>{};
+
+        auto write_task = channel.async_write(1, asio::use_future);
+        auto read_task = channel.async_read(asio::use_future);
+        write_task.get();
+        CHECK(read_task.get() == 1);
+
+        auto void_read_task = void_channel.async_read(asio::use_future);
+        auto void_write_task = void_channel.async_write(asio::use_future);
+        void_write_task.get();
+        void_read_task.get();
+    }
+
+    SECTION("Select")
+    {
+        auto thread_pool = asio::thread_pool{1};
+        auto channel_1 = asiochan::channel<int>{};
+        auto channel_2 = asiochan::channel<int>{};
+
+        auto select_task = asiochan::async_select(
+            asio::use_future,
+            asiochan::ops::read(channel_1, channel_2));
+
+        auto write_task = asio::co_spawn(
+            thread_pool,
+            [channel_2]() mutable -> asio::awaitable<void>
+            {
+                co_await channel_2.write(2);
+            },
+            asio::use_future);
+
+        auto const result = select_task.get();
+        write_task.get();
+        CHECK(result.received_from(channel_2));
+        CHECK(result.get_received<int>() == 2);
+    }
+
+    SECTION("Awaitable")
+    {
+        auto thread_pool = asio::thread_pool{1};
+        auto channel = asiochan::channel<int>{};
+
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<int>
+            {
+                co_return co_await channel.async_read(asio::use_awaitable);
+            },
+            asio::use_future);
+
+        auto write_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                co_await channel.async_write(3, asio::use_awaitable);
+            },
+            asio::use_future);
+
+        CHECK(read_task.get() == 3);
+        write_task.get();
+    }
+}
+
+TEST_CASE("Select results")
+{
+    auto ints_1 = asiochan::channel<int, 1>{};
+    auto ints_2 = asiochan::channel<int, 1>{};
+    auto strings = asiochan::channel<std::string, 1>{};
+
+    auto const select_ready = [&]()
+    {
+        return asiochan::select_ready(
+            asiochan::ops::read(ints_1, ints_2),
+            asiochan::ops::read(strings),
+            asiochan::ops::nothing);
+    };
+
+    SECTION("Alternatives map to operations")
+    {
+        REQUIRE(ints_2.try_write(2));
+        auto const int_result = select_ready();
+        CHECK(int_result.alternative() == 1);
+        CHECK(int_result.op_index() == 0);
+        CHECK(int_result.received<int>());
+        CHECK(not int_result.received<std::string>());
+
+        REQUIRE(strings.try_write("hello"));
+        auto const string_result = select_ready();
+        CHECK(string_result.alternative() == 2);
+        CHECK(string_result.op_index() == 1);
+        CHECK(string_result.received<std::string>());
+
+        auto const no_result = select_ready();
+        CHECK(no_result.alternative() == 3);
+        CHECK(no_result.op_index() == 2);
+        CHECK(not no_result.has_value());
+    }
+
+    SECTION("Visit")
+    {
+        auto const describe = []<typename Result>(Result const& result) -> std::string
+        {
+            if constexpr (std::same_as<Result, asiochan::read_result<int>>)
+            {
+                return std::to_string(result.get());
+            }
+            else if constexpr (std::same_as<Result, asiochan::read_result<std::string>>)
+            {
+                return result.get();
+            }
+            else
+            {
+                return "nothing";
+            }
+        };
+
+        REQUIRE(ints_1.try_write(1));
+        CHECK(select_ready().visit(describe) == "1");
+
+        REQUIRE(strings.try_write("hello"));
+        auto result = select_ready();
+        auto const moved = std::move(result).visit(
+            []<typename Result>(Result&& alternative) -> std::string
+            {
+                if constexpr (std::same_as<Result, asiochan::read_result<std::string>>)
+                {
+                    return std::move(alternative.get());
+                }
+                return {};
+            });
+        CHECK(moved == "hello");
+
+        CHECK(select_ready().visit(describe) == "nothing");
+    }
+
+    SECTION("Ready operations complete without suspending")
+    {
+        auto io_context = asio::io_context{1};
+        auto num_completed = 0;
+        asiochan::detail::inline_completions() = 0;
+
+        REQUIRE(ints_1.try_write(1));
+        REQUIRE(strings.try_write("hello"));
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                auto const result = co_await asiochan::select(
+                    asiochan::ops::read(ints_1, ints_2),
+                    asiochan::ops::read(strings));
+                CHECK(result.received_from(ints_1));
+                ++num_completed;
+
+                auto const received = co_await strings.read();
+                CHECK(received == "hello");
+                co_await ints_2.write(2);
+                ++num_completed;
+            },
+            asio::detached);
+
+        // A single handler runs the coroutine to completion.
+        CHECK(io_context.run_one() == 1);
+        CHECK(num_completed == 2);
+        CHECK(ints_2.try_read() == std::optional{2});
+    }
+
+    SECTION("Always ready operations let other handlers run")
+    {
+        static constexpr auto num_values = 200;
+
+        auto io_context = asio::io_context{1};
+        auto channel = asiochan::channel<int, num_values>{};
+        auto other_handler_ran = false;
+        auto num_read_before = std::optional<int>{};
+
+        for (auto i = 0; i < num_values; ++i)
+        {
+            REQUIRE(channel.try_write(i));
+        }
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                for (auto i = 0; i < num_values; ++i)
+                {
+                    if (other_handler_ran and not num_read_before)
+                    {
+                        num_read_before = i;
+                    }
+                    co_await channel.read();
+                }
+            },
+            asio::detached);
+        asio::post(
+            io_context,
+            [&]()
+            {
+                other_handler_ran = true;
+            });
+
+        io_context.run();
+        REQUIRE(num_read_before.has_value());
+        CHECK(*num_read_before <= static_cast<int>(asiochan::detail::max_inline_completions));
+    }
+}
+
+TEST_CASE("Blocking operations")
+{
+    auto thread_pool = asio::thread_pool{1};
+
+    SECTION("Blocking read from coroutine writer")
+    {
+        auto channel = asiochan::channel<std::string>{};
+
+        auto write_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                co_await channel.write("ping");
+            },
+            asio::use_future);
+
+        CHECK(channel.blocking_read() == "ping");
+        write_task.get();
+    }
+
+    SECTION("Blocking write to coroutine reader")
+    {
+        auto channel = asiochan::channel<void>{};
+
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                co_await channel.read();
+            },
+            asio::use_future);
+
+        channel.blocking_write();
+        read_task.get();
+    }
+
+    SECTION("Blocking writer feeds a coroutine reader through a buffer")
+    {
+        static constexpr auto num_values = 100;
+
+        auto channel = asiochan::channel<int, 1>{};
+        auto writer = std::thread{
+            [channel]() mutable
+            {
+                for (auto const i : std::views::iota(0, num_values))
+                {
+                    channel.blocking_write(i);
+                }
+            }};
+
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                for (auto const i : std::views::iota(0, num_values))
+                {
+                    auto const recv = co_await channel.read();
+                    CHECK(recv == i);
+                }
+            },
+            asio::use_future);
+
+        read_task.get();
+        writer.join();
+    }
+
+    SECTION("Blocking and coroutine writers are served in FIFO order")
+    {
+        auto channel = asiochan::basic_channel<
+            int,
+            1,
+            asio::any_io_executor,
+            asiochan::instrumented_channel_policy>{};
+        auto const wait_for_parked_writers = [&](std::size_t const num_parked)
+        {
+            while (channel.stats().writes.parked != num_parked)
+            {
+                std::this_thread::yield();
+            }
+        };
+
+        REQUIRE(channel.try_write(0));
+
+        auto first_writer = std::thread{
+            [channel]() mutable
+            {
+                channel.blocking_write(1);
+            }};
+        wait_for_parked_writers(1);
+
+        auto write_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                co_await channel.write(2);
+            },
+            asio::use_future);
+        wait_for_parked_writers(2);
+
+        auto last_writer = std::thread{
+            [channel]() mutable
+            {
+                channel.blocking_write(3);
+            }};
+        wait_for_parked_writers(3);
+
+        for (auto const i : std::views::iota(0, 4))
+        {
+            CHECK(channel.blocking_read() == i);
+        }
+
+        first_writer.join();
+        write_task.get();
+        last_writer.join();
+    }
+}
+
+namespace
+{
+    struct move_counted
+    {
+        static inline auto num_moves = 0;
+
+        int value = 0;
+
+        explicit move_counted(int const value) noexcept
+          : value{value}
+        {
+        }
+
+        move_counted(move_counted&& other) noexcept
+          : value{other.value}
+        {
+            ++num_moves;
+        }
+
+        auto operator=(move_counted&& other) noexcept -> move_counted&
+        {
+            value = other.value;
+            ++num_moves;
+            return *this;
+        }
+    };
+}  // namespace
+
+TEST_CASE("In-place operations")
+{
+    auto io_context = asio::io_context{1};
+    move_counted::num_moves = 0;
+
+    SECTION("Buffered channel")
+    {
+        auto channel = asiochan::channel<move_counted, 3>{};
+
+        for (auto i = 0; i < 3; ++i)
+        {
+            REQUIRE(channel.try_emplace_write(i));
+        }
+        CHECK(not channel.try_emplace_write(3));
+
+        auto peeked = -1;
+        CHECK(channel.try_peek(
+            [&](move_counted const& message)
+            {
+                peeked = message.value;
+            }));
+        CHECK(peeked == 0);
+
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto received = -1;
+            REQUIRE(channel.try_read_with(
+                [&](move_counted& message)
+                {
+                    received = message.value;
+                }));
+            CHECK(received == i);
+        }
+
+        CHECK(not channel.try_peek([](move_counted const&) {}));
+        CHECK(not channel.try_read_with([](move_counted&) {}));
+        CHECK(move_counted::num_moves == 0);
+    }
+
+    SECTION("Unbuffered channel with a waiting reader")
+    {
+        auto channel = asiochan::channel<move_counted>{};
+        auto received = -1;
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                co_await channel.read_with(
+                    [&](move_counted& message)
+                    {
+                        received = message.value;
+                    });
+            },
+            asio::detached);
+
+        io_context.poll();
+        REQUIRE(channel.try_emplace_write(42));
+        CHECK(move_counted::num_moves == 0);
+
+        io_context.run();
+        CHECK(received == 42);
+    }
+
+    SECTION("Unbuffered channel with a waiting writer")
+    {
+        auto channel = asiochan::channel<move_counted>{};
+        auto written = false;
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                co_await channel.emplace_write(42);
+                written = true;
+            },
+            asio::detached);
+
+        io_context.poll();
+        auto const moves_before_read = move_counted::num_moves;
+
+        // The writer is claimed, and the channel not locked while the callback runs.
+        auto received = -1;
+        REQUIRE(channel.try_read_with(
+            [&](move_counted& message)
+            {
+                received = message.value;
+                CHECK(not channel.try_read().has_value());
+            }));
+        CHECK(received == 42);
+        CHECK(move_counted::num_moves == moves_before_read);
+
+        io_context.run();
+        CHECK(written);
+    }
+
+    SECTION("Loan channel")
+    {
+        auto channel = asiochan::basic_channel<
+            move_counted,
+            2,
+            asio::any_io_executor,
+            asiochan::loan_channel_policy>{};
+        REQUIRE(channel.try_emplace_write(1));
+
+        // The value is pinned by a read loan, so the callback can use the channel.
+        auto received = -1;
+        REQUIRE(channel.try_read_with(
+            [&](move_counted& message)
+            {
+                received = message.value;
+                CHECK(channel.try_emplace_write(2));
+            }));
+        CHECK(received == 1);
+
+        REQUIRE(channel.try_read_with(
+            [&](move_counted& message)
+            {
+                received = message.value;
+            }));
+        CHECK(received == 2);
+        CHECK(move_counted::num_moves == 0);
+    }
+
+    SECTION("Values are released when the callback throws")
+    {
+        auto channel = asiochan::channel<move_counted, 1>{};
+        REQUIRE(channel.try_emplace_write(1));
+
+        CHECK_THROWS(channel.try_read_with(
+            [](move_counted&)
+            {
+                throw std::runtime_error{"callback failed"};
+            }));
+
+        CHECK(not channel.try_read_with([](move_counted&) {}));
+    }
+}
+
+TEST_CASE("Buffer storage")
+{
+    using buffer_type = asiochan::detail::channel_buffer<std::uint64_t, 4096>;
+    static_assert(sizeof(buffer_type) <= 4096 * sizeof(std::uint64_t) + 2 * sizeof(std::size_t));
+
+    auto const tracker = std::make_shared<int>(0);
+
+    SECTION("Buffered values are destroyed with the channel")
+    {
+        {
+            auto channel = asiochan::channel<std::shared_ptr<int>, 4>{};
+            for (auto i = 0; i < 3; ++i)
+            {
+                REQUIRE(channel.try_write(tracker));
+            }
+            CHECK(tracker.use_count() == 4);
+        }
+
+        CHECK(tracker.use_count() == 1);
+    }
+
+    SECTION("Values survive wrapping around the ring")
+    {
+        auto channel = asiochan::channel<std::shared_ptr<int>, 3>{};
+        for (auto i = 0; i < 10; ++i)
+        {
+            REQUIRE(channel.try_write(std::make_shared<int>(i)));
+            REQUIRE(channel.try_write(tracker));
+
+            auto const first = channel.try_read();
+            REQUIRE(first);
+            CHECK(**first == i);
+
+            auto const second = channel.try_read();
+            REQUIRE(second);
+            CHECK(*second == tracker);
+        }
+
+        CHECK(tracker.use_count() == 1);
+    }
+}
+
+TEST_CASE("Channel loans")
+{
+    using packet = std::array<int, 16>;
+    using loan_channel = asiochan::basic_channel<
+        packet,
+        2,
+        asio::any_io_executor,
+        asiochan::loan_channel_policy>;
+
+    auto io_context = asio::io_context{1};
+    auto channel = loan_channel{};
+
+    SECTION("Values are delivered in reservation order")
+    {
+        auto first = channel.try_reserve();
+        auto second = channel.try_reserve();
+        REQUIRE(first);
+        REQUIRE(second);
+        CHECK(not channel.try_reserve());
+
+        (**first)[0] = 1;
+        (**second)[0] = 2;
+        second->commit();
+        CHECK(not channel.try_acquire());
+
+        first->commit();
+        auto loan = channel.try_acquire();
+        REQUIRE(loan);
+        CHECK((**loan)[0] == 1);
+        CHECK(channel.try_read() == packet{2});
+    }
+
+    SECTION("Abandoned reservations are skipped")
+    {
+        auto first = channel.try_reserve();
+        REQUIRE(first);
+        {
+            auto second = channel.try_reserve();
+            REQUIRE(second);
+            (**second)[0] = 2;
+            second->commit();
+        }
+
+        first.reset();
+        CHECK(channel.try_read() == packet{2});
+        CHECK(channel.try_write(packet{3}));
+        CHECK(channel.try_write(packet{4}));
+    }
+
+    SECTION("Abandoning a reservation wakes waiting acquirers")
+    {
+        auto first = channel.try_reserve();
+        auto second = channel.try_reserve();
+        REQUIRE(first);
+        REQUIRE(second);
+        (**second)[0] = 2;
+        second->commit();
+
+        auto acquired = -1;
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                auto loan = co_await channel.acquire();
+                acquired = (*loan)[0];
+            },
+            asio::detached);
+
+        io_context.run_one();
+        CHECK(acquired == -1);
+
+        first.reset();
+        io_context.run();
+        CHECK(acquired == 2);
+    }
+
+    SECTION("Slots are freed in order once released")
+    {
+        REQUIRE(channel.try_write(packet{1}));
+        REQUIRE(channel.try_write(packet{2}));
+
+        auto first = channel.try_acquire();
+        auto second = channel.try_acquire();
+        REQUIRE(first);
+        REQUIRE(second);
+        CHECK((**second)[0] == 2);
+
+        second->release();
+        CHECK(not channel.try_write(packet{3}));
+
+        first->release();
+        CHECK(channel.try_write(packet{3}));
+        CHECK(channel.try_write(packet{4}));
+    }
+
+    SECTION("Waiting for loans")
+    {
+        auto received = std::vector<int>{};
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                for (auto i = 0; i < 4; ++i)
+                {
+                    auto loan = co_await channel.acquire();
+                    received.push_back((*loan)[0]);
+                }
+            },
+            asio::detached);
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                for (auto i = 0; i < 4; ++i)
+                {
+                    auto loan = co_await channel.reserve();
+                    (*loan)[0] = i;
+                    loan.commit();
+                }
+            },
+            asio::detached);
+
+        io_context.run();
+        CHECK(received == std::vector{0, 1, 2, 3});
+    }
+
+    SECTION("Loans on a thread pool")
+    {
+        static constexpr auto num_values = 1000;
+        static constexpr auto num_tasks = 4;
+
+        auto thread_pool = asio::thread_pool{4};
+        auto tasks = std::vector<std::future<int>>{};
+
+        for (auto t = 0; t < num_tasks; ++t)
+        {
+            asio::co_spawn(
+                thread_pool,
+                [channel]() mutable -> asio::awaitable<void>
+                {
+                    for (auto i = 0; i < num_values; ++i)
+                    {
+                        auto loan = co_await channel.reserve();
+                        (*loan)[0] = i;
+                        loan.commit();
+                    }
+                },
+                asio::detached);
+
+            tasks.push_back(asio::co_spawn(
+                thread_pool,
+                [channel]() mutable -> asio::awaitable<int>
+                {
+                    auto sum = 0;
+                    for (auto i = 0; i < num_values; ++i)
+                    {
+                        auto loan = co_await channel.acquire();
+                        sum += (*loan)[0];
+                    }
+                    co_return sum;
+                },
+                asio::use_future));
+        }
+
+        auto sum = 0;
+        for (auto& task : tasks)
+        {
+            sum += task.get();
+        }
+
+        CHECK(sum == num_tasks * (num_values * (num_values - 1) / 2));
+    }
+
+    SECTION("Commits complete parked readers and released slots complete parked writers")
+    {
+        auto read_value = -1;
+        auto written = false;
+
+        auto loan = channel.try_reserve();
+        REQUIRE(loan);
+        (**loan)[0] = 7;
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                auto const value = co_await channel.read();
+                read_value = value[0];
+            },
+            asio::detached);
+
+        io_context.poll();
+        loan->commit();
+        io_context.poll();
+        CHECK(read_value == 7);
+
+        REQUIRE(channel.try_write(packet{1}));
+        REQUIRE(channel.try_write(packet{2}));
+        auto read_loan = channel.try_acquire();
+        REQUIRE(read_loan);
+
+        io_context.restart();
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                co_await channel.write(packet{3});
+                written = true;
+            },
+            asio::detached);
+
+        io_context.poll();
+        CHECK(not written);
+
+        read_loan->release();
+        io_context.poll();
+        CHECK(written);
+    }
+}
+
+TEST_CASE("Channel statistics")
+{
+    using instrumented_channel = asiochan::basic_channel<
+        int,
+        2,
+        asio::any_io_executor,
+        asiochan::instrumented_channel_policy>;
+
+    static_assert(sizeof(asiochan::detail::channel_shared_state<int, asio::any_io_executor, 2>)
+                  < sizeof(instrumented_channel::shared_state_type));
+
+    auto thread_pool = asio::thread_pool{1};
+    auto channel = instrumented_channel{};
+
+    SECTION("Wait-free operations and buffer occupancy")
+    {
+        CHECK(channel.try_write(1));
+        CHECK(channel.try_write(2));
+        CHECK(not channel.try_write(3));
+
+        auto stats = channel.stats();
+        CHECK(stats.buffer_size == 2);
+        CHECK(stats.peak_buffer_size == 2);
+        CHECK(stats.writes.completed == 2);
+        CHECK(stats.writes.waitfree == 2);
+
+        CHECK(channel.try_read() == 1);
+        CHECK(channel.try_read() == 2);
+
+        stats = channel.stats();
+        CHECK(stats.buffer_size == 0);
+        CHECK(stats.peak_buffer_size == 2);
+        CHECK(stats.reads.waitfree == 2);
+        CHECK(stats.reads.suspended == 0);
+    }
+
+    SECTION("Suspended operations and parked waiters")
+    {
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<int>
+            {
+                co_return co_await channel.read();
+            },
+            asio::use_future);
+
+        while (channel.stats().reads.parked == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        channel.blocking_write(42);
+        CHECK(read_task.get() == 42);
+
+        auto const stats = channel.stats();
+        CHECK(stats.reads.parked == 0);
+        CHECK(stats.reads.suspended == 1);
+        CHECK(stats.reads.wait_times.total() == 1);
+        CHECK(stats.writes.waitfree == 1);
+    }
+}
+
+TEST_CASE("Channel registry")
+{
+    using registered_channel = asiochan::basic_channel<
+        int,
+        4,
+        asio::any_io_executor,
+        asiochan::registered_channel_policy>;
+
+    // Only registered or traced channels stamp their parked waiters.
+    static_assert(sizeof(asiochan::ops::read<int, asiochan::channel<int>>::waiter_node_type)
+                  < sizeof(asiochan::ops::read<int, registered_channel>::waiter_node_type));
+
+    auto& registry = asiochan::channel_registry::global();
+    auto const find_report = [&](std::string const& name)
+    {
+        auto result = std::optional<asiochan::channel_report>{};
+        registry.for_each(
+            [&](asiochan::channel_report const& report)
+            {
+                if (report.name == name)
+                {
+                    result = report;
+                }
+            });
+
+        return result;
+    };
+
+    SECTION("Channels are registered while alive")
+    {
+        auto const num_registered = registry.size();
+        {
+            auto channel = registered_channel{"numbers"};
+            CHECK(registry.size() == num_registered + 1);
+            CHECK(channel.try_write(1));
+
+            auto const report = find_report("numbers");
+            REQUIRE(report.has_value());
+            CHECK(report->buffer_size == 1);
+            CHECK(report->buffer_capacity == 4);
+            CHECK(report->parked_readers == 0);
+            CHECK(not report->oldest_waiter_age.has_value());
+        }
+        CHECK(registry.size() == num_registered);
+        CHECK(not find_report("numbers").has_value());
+    }
+
+    SECTION("Unbounded channels report no buffer capacity")
+    {
+        using registered_unbounded_channel = asiochan::basic_channel<
+            int,
+            asiochan::unbounded_channel_buff,
+            asio::any_io_executor,
+            asiochan::registered_channel_policy>;
+
+        auto channel = registered_unbounded_channel{"unbounded"};
+        channel.write(1);
+        channel.write(2);
+
+        auto const report = find_report("unbounded");
+        REQUIRE(report.has_value());
+        CHECK(report->buffer_size == 2);
+        CHECK(not report->buffer_capacity.has_value());
+        CHECK(report->parked_writers == 0);
+    }
+
+    SECTION("Parked waiters are reported with their age")
+    {
+        auto thread_pool = asio::thread_pool{1};
+        auto channel = registered_channel{"stalled"};
+
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<int>
+            {
+                co_return co_await channel.read();
+            },
+            asio::use_future);
+
+        while (find_report("stalled")->parked_readers == 0)
+        {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(5ms);
+
+        auto const report = find_report("stalled");
+        REQUIRE(report.has_value());
+        CHECK(report->parked_readers == 1);
+        REQUIRE(report->oldest_waiter_age.has_value());
+        CHECK(*report->oldest_waiter_age >= 5ms);
+
+        channel.blocking_write(1);
+        CHECK(read_task.get() == 1);
+    }
+}
+
+TEST_CASE("Lock profiling")
+{
+    static constexpr auto num_writers = 4;
+    static constexpr auto num_values = 1000;
+
+    using profiled_channel = asiochan::basic_channel<
+        int,
+        16,
+        asio::any_io_executor,
+        asiochan::profiled_channel_policy>;
+
+    auto thread_pool = asio::thread_pool{num_writers};
+    auto channel = profiled_channel{};
+#ifdef ASIOCHAN_PROFILE_SELECT_LOCKS
+    asiochan::select_lock_profile().reset();
+#endif
+
+    auto tasks = std::vector<std::future<void>>{};
+    for (auto i = 0; i < num_writers; ++i)
+    {
+        tasks.push_back(asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                for (auto const value : std::views::iota(0, num_values))
+                {
+                    co_await channel.write(value);
+                }
+            },
+            asio::use_future));
+    }
+
+    for (auto i = 0; i < num_writers * num_values; ++i)
+    {
+        [[maybe_unused]] auto const value = channel.blocking_read();
+    }
+    for (auto& task : tasks)
+    {
+        task.get();
+    }
+
+    auto const stats = channel.stats();
+    CHECK(stats.lock.acquisitions >= 2 * num_writers * num_values);
+    CHECK(stats.lock.contended <= stats.lock.acquisitions);
+    CHECK((stats.lock.contended == 0) == (stats.lock.blocked == 0ns));
+    CHECK(stats.writes.completed == num_writers * num_values);
+
+#ifdef ASIOCHAN_PROFILE_SELECT_LOCKS
+    auto const select_stats = asiochan::select_lock_profile().snapshot();
+    CHECK(select_stats.acquisitions > 0);
+    CHECK(select_stats.contended <= select_stats.acquisitions);
+#endif
+}
+
+namespace
+{
+    struct traced_loan_channel_policy
+    {
+        using tracer_type = asiochan::channel_tracer;
+        static constexpr bool loans = true;
+    };
+}  // namespace
+
+TEST_CASE("Channel tracing")
+{
+    using traced_channel = asiochan::basic_channel<
+        int,
+        2,
+        asio::any_io_executor,
+        asiochan::traced_channel_policy>;
+
+    static_assert(sizeof(asiochan::detail::channel_shared_state<int, asio::any_io_executor, 2>)
+                  < sizeof(traced_channel::shared_state_type));
+
+    auto& log = asiochan::channel_trace_log::global();
+    log.clear();
+
+    auto thread_pool = asio::thread_pool{1};
+    auto channel = traced_channel{};
+
+    SECTION("Messages are traced from enqueue to dequeue")
+    {
+        CHECK(channel.try_write(1));
+        CHECK(channel.try_write(2));
+        CHECK(channel.try_read() == 1);
+        CHECK(channel.try_read() == 2);
+
+        auto const events = log.events();
+        REQUIRE(events.size() == 4);
+        CHECK(events[0].kind == asiochan::channel_trace_event_kind::write_enqueued);
+        CHECK(events[0].sequence == 0);
+        CHECK(events[1].sequence == 1);
+        CHECK(events[2].kind == asiochan::channel_trace_event_kind::read_dequeued);
+        CHECK(events[2].sequence == 0);
+        CHECK(events[2].time >= events[0].time);
+
+        auto out = std::ostringstream{};
+        log.write_chrome_trace(out);
+        auto const json = out.str();
+        CHECK(json.starts_with(R"({"traceEvents":[)"));
+        CHECK(json.find(R"("name":"message 0")") != std::string::npos);
+        CHECK(json.find(R"("name":"message 1")") != std::string::npos);
+    }
+
+    SECTION("Messages in flight are exported as async spans")
+    {
+        CHECK(channel.try_write(1));
+        CHECK(channel.try_write(2));
+        CHECK(channel.try_read() == 1);
+        CHECK(channel.try_read() == 2);
+
+        auto out = std::ostringstream{};
+        log.write_chrome_trace(out);
+        auto const json = out.str();
+        CHECK(json.find(R"("ph":"X")") == std::string::npos);
+
+        auto const find_span_event = [&](int const sequence, char const phase)
+        {
+            auto const prefix = std::string{R"({"name":"message )"} + std::to_string(sequence)
+                                + R"(","cat":"asiochan.channel1","ph":")" + phase
+                                + R"(","id":)" + std::to_string(sequence) + R"(,"pid":1,"tid":1,"ts":)";
+            auto const pos = json.find(prefix);
+            REQUIRE(pos != std::string::npos);
+            return std::stod(json.substr(pos + prefix.size()));
+        };
+
+        auto const begin_0 = find_span_event(0, 'b');
+        auto const end_0 = find_span_event(0, 'e');
+        auto const begin_1 = find_span_event(1, 'b');
+        auto const end_1 = find_span_event(1, 'e');
+        CHECK(begin_0 <= begin_1);
+        CHECK(begin_1 <= end_0);
+        CHECK(end_0 <= end_1);
+    }
+
+    SECTION("Parked waiters are traced")
+    {
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<int>
+            {
+                co_return co_await channel.read();
+            },
+            asio::use_future);
+
+        while (log.events().empty())
+        {
+            std::this_thread::yield();
+        }
+
+        channel.blocking_write(1);
+        CHECK(read_task.get() == 1);
+
+        auto const events = log.events();
+        REQUIRE(events.size() == 4);
+        CHECK(events[0].kind == asiochan::channel_trace_event_kind::waiter_parked);
+        CHECK(events[0].op == asiochan::channel_op_kind::read);
+        CHECK(events[3].kind == asiochan::channel_trace_event_kind::waiter_woken);
+        CHECK(events[3].op == asiochan::channel_op_kind::read);
+    }
+
+    SECTION("Messages of parked writers are traced from when the writer parked")
+    {
+        REQUIRE(channel.try_write(1));
+        REQUIRE(channel.try_write(2));
+
+        auto write_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                co_await channel.write(3);
+            },
+            asio::use_future);
+
+        while (log.events().size() < 3)
+        {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(10ms);
+
+        CHECK(channel.try_read() == 1);
+        write_task.get();
+        CHECK(channel.try_read() == 2);
+        CHECK(channel.try_read() == 3);
+
+        auto const events = log.events();
+        auto const find_event = [&](asiochan::channel_trace_event_kind const kind, std::uint64_t const sequence)
+        {
+            return std::ranges::find_if(
+                events,
+                [&](asiochan::channel_trace_event const& event)
+                {
+                    return event.kind == kind and event.sequence == sequence;
+                });
+        };
+
+        auto const parked = find_event(asiochan::channel_trace_event_kind::waiter_parked, 0);
+        auto const enqueued = find_event(asiochan::channel_trace_event_kind::write_enqueued, 2);
+        auto const dequeued = find_event(asiochan::channel_trace_event_kind::read_dequeued, 2);
+        REQUIRE(parked != events.end());
+        REQUIRE(enqueued != events.end());
+        REQUIRE(dequeued != events.end());
+        CHECK(enqueued->time == parked->time);
+        CHECK(dequeued->time - enqueued->time >= 10ms);
+    }
+
+    SECTION("Loaned messages are traced in delivery order")
+    {
+        auto loan_channel = asiochan::basic_channel<
+            int,
+            2,
+            asio::any_io_executor,
+            traced_loan_channel_policy>{};
+
+        auto const num_enqueued = [&]()
+        {
+            return std::ranges::count(
+                log.events(),
+                asiochan::channel_trace_event_kind::write_enqueued,
+                &asiochan::channel_trace_event::kind);
+        };
+
+        auto first = loan_channel.try_reserve();
+        auto second = loan_channel.try_reserve();
+        REQUIRE(first);
+        REQUIRE(second);
+        **first = 1;
+        **second = 2;
+
+        // The second value cannot be read before the first, so it is not traced yet.
+        second->commit();
+        CHECK(num_enqueued() == 0);
+
+        first->commit();
+        CHECK(num_enqueued() == 2);
+        CHECK(loan_channel.try_read() == 1);
+        CHECK(loan_channel.try_read() == 2);
+
+        auto const events = log.events();
+        REQUIRE(events.size() == 4);
+        CHECK(events[0].kind == asiochan::channel_trace_event_kind::write_enqueued);
+        CHECK(events[0].sequence == 0);
+        CHECK(events[1].kind == asiochan::channel_trace_event_kind::write_enqueued);
+        CHECK(events[1].sequence == 1);
+        CHECK(events[2].kind == asiochan::channel_trace_event_kind::read_dequeued);
+        CHECK(events[2].sequence == 0);
+        CHECK(events[2].time >= events[1].time);
+    }
+}
+
+TEST_CASE("Single threaded channels")
+{
+    using local_channel = asiochan::basic_channel<
+        int,
+        0,
+        asio::any_io_executor,
+        asiochan::single_threaded_channel_policy>;
+
+    static_assert(asiochan::ops::read<int, local_channel>::executor_affine);
+    static_assert(not asiochan::ops::read<int, asiochan::channel<int>>::executor_affine);
+
+    auto const run_ping_pong = [](auto executor, auto run)
+    {
+        static constexpr auto num_rounds = 1000;
+
+        auto ping = local_channel{};
+        auto pong = local_channel{};
+
+        auto echo_task = asio::co_spawn(
+            executor,
+            [ping, pong]() mutable -> asio::awaitable<void>
+            {
+                for (auto i = 0; i < num_rounds; ++i)
+                {
+                    auto const value = co_await ping.read();
+                    co_await pong.write(value + 1);
+                }
+            },
+            asio::use_future);
+
+        auto main_task = asio::co_spawn(
+            executor,
+            [ping, pong]() mutable -> asio::awaitable<int>
+            {
+                auto value = 0;
+                for (auto i = 0; i < num_rounds; ++i)
+                {
+                    co_await ping.write(value);
+                    value = co_await pong.read();
+                }
+                co_return value;
+            },
+            asio::use_future);
+
+        run();
+        echo_task.get();
+        CHECK(main_task.get() == num_rounds);
+    };
+
+    SECTION("On a single threaded io_context")
+    {
+#ifdef ASIOCHAN_PROFILE_SELECT_LOCKS
+        asiochan::select_lock_profile().reset();
+#endif
+
+        auto io_context = asio::io_context{1};
+        run_ping_pong(
+            io_context.get_executor(),
+            [&]()
+            {
+                io_context.run();
+            });
+
+#ifdef ASIOCHAN_PROFILE_SELECT_LOCKS
+        // The wait contexts of executor affine selects are never locked.
+        CHECK(asiochan::select_lock_profile().snapshot().acquisitions == 0);
+#endif
+    }
+
+    SECTION("On a strand of a thread pool")
+    {
+        auto thread_pool = asio::thread_pool{4};
+        run_ping_pong(
+            asio::make_strand(thread_pool),
+            [&]()
+            {
+                thread_pool.join();
+            });
+    }
+}
+
+TEST_CASE("Batched wake-ups")
+{
+    using bridged_channel = asiochan::basic_channel<
+        int,
+        0,
+        asio::any_io_executor,
+        asiochan::batched_wakeup_channel_policy>;
+
+    static_assert(asiochan::ops::read<int, bridged_channel>::batch_wakeups);
+    static_assert(not asiochan::ops::read<int, asiochan::channel<int>>::batch_wakeups);
+
+    static constexpr auto num_readers = 16;
+
+    auto io_context = asio::io_context{1};
+    auto channel = bridged_channel{};
+    auto sum = 0;
+    auto num_received = 0;
+
+    for (auto i = 0; i < num_readers; ++i)
+    {
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                auto const value = co_await channel.read();
+                sum += value;
+                ++num_received;
+            },
+            asio::detached);
+    }
+
+    // Park all readers.
+    io_context.poll();
+    REQUIRE(num_received == 0);
+
+    for (auto i = 0; i < num_readers; ++i)
+    {
+        REQUIRE(channel.try_write(i));
+    }
+
+    // A single handler resumes every reader woken by the writes above.
+    CHECK(io_context.poll_one() == 1);
+    CHECK(num_received == num_readers);
+    CHECK(sum == num_readers * (num_readers - 1) / 2);
+
+    io_context.run();
+}
+
+TEST_CASE("Batched wake-ups pending at shutdown")
+{
+    using bridged_channel = asiochan::basic_channel<
+        int,
+        0,
+        asio::any_io_executor,
+        asiochan::batched_wakeup_channel_policy>;
+
+    auto const tracker = std::make_shared<int>(0);
+    auto channel = bridged_channel{};
+    auto num_received = 0;
+
+    {
+        auto io_context = asio::io_context{1};
+
+        for (auto i = 0; i < 2; ++i)
+        {
+            asio::co_spawn(
+                io_context,
+                [&, tracker]() -> asio::awaitable<void>
+                {
+                    co_await channel.read();
+                    ++num_received;
+                },
+                asio::detached);
+        }
+
+        io_context.poll();
+        REQUIRE(tracker.use_count() == 3);
+
+        // Queue a batched wake-up, and destroy the context before it runs.
+        REQUIRE(channel.try_write(1));
+        REQUIRE(channel.try_write(2));
+    }
+
+    // The frames of the woken readers are destroyed with the context, without resuming them.
+    CHECK(num_received == 0);
+    CHECK(tracker.use_count() == 1);
+}
+
+TEST_CASE("NUMA placement")
+{
+    using numa_channel = asiochan::basic_channel<
+        int,
+        4,
+        asio::any_io_executor,
+        asiochan::numa_channel_policy>;
+
+    REQUIRE(asiochan::numa_node_count() >= 1);
+    CHECK(asiochan::current_numa_node() < asiochan::numa_node_count());
+
+    auto const node = asiochan::numa_node_count() - 1;
+    auto channel = numa_channel{std::allocator_arg, asiochan::numa_allocator<std::byte>{node}};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        REQUIRE(channel.try_write(i));
+    }
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        CHECK(channel.try_read() == i);
+    }
+
+    auto default_channel = numa_channel{};
+    CHECK(not default_channel.try_read());
+
+    SECTION("Binding is forced on single node machines")
+    {
+        static constexpr auto num_values = 16;
+
+        auto allocator = asiochan::numa_allocator<int>{0, asiochan::numa_binding::always};
+        CHECK(allocator != asiochan::numa_allocator<int>{0});
+
+        auto const values = allocator.allocate(num_values);
+#if defined(__linux__)
+        // Bound allocations are mapped, so they start on a page boundary.
+        CHECK(reinterpret_cast<std::uintptr_t>(values) % 4096 == 0);
+#endif
+        std::iota(values, values + num_values, 0);
+        CHECK(std::accumulate(values, values + num_values, 0) == num_values * (num_values - 1) / 2);
+        allocator.deallocate(values, num_values);
+
+        auto bound_channel = numa_channel{
+            std::allocator_arg,
+            asiochan::numa_allocator<std::byte>{0, asiochan::numa_binding::always}};
+        REQUIRE(bound_channel.try_write(42));
+        CHECK(bound_channel.try_read() == std::optional{42});
+    }
+}
+
+TEST_CASE("Adaptive spin")
+{
+    auto thread_pool = asio::thread_pool{2};
+
+    SECTION("Spinning reader receives from writer on another thread")
+    {
+        static constexpr auto num_values = 1000;
+
+        auto channel = asiochan::channel<int>{};
+        auto spin = asiochan::adaptive_spin{};
+
+        auto write_task = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                for (auto const i : std::views::iota(0, num_values))
+                {
+                    co_await channel.write(i);
+                }
+            },
+            asio::use_future);
+
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel, &spin]() mutable -> asio::awaitable<void>
+            {
+                for (auto const i : std::views::iota(0, num_values))
+                {
+                    auto const recv = co_await channel.read(spin);
+                    CHECK(recv == i);
+                }
+            },
+            asio::use_future);
+
+        read_task.get();
+        write_task.get();
+
+        CHECK(spin.budget() >= asiochan::adaptive_spin::min_budget);
+        CHECK(spin.budget() <= spin.max_budget());
+    }
+
+    SECTION("Long parked waits shrink the budget")
+    {
+        auto channel = asiochan::channel<void>{};
+        auto spin = asiochan::adaptive_spin{1024};
+
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel, &spin]() mutable -> asio::awaitable<void>
+            {
+                co_await channel.read(spin);
+            },
+            asio::use_future);
+
+        CHECK(read_task.wait_for(20ms) == std::future_status::timeout);
+        CHECK(spin.budget() == 1024);
+
+        channel.blocking_write();
+        read_task.get();
+        CHECK(spin.budget() == 512);
+    }
+
+    SECTION("The budget recovers from its minimum once peers arrive soon after parking")
+    {
+        auto spin = asiochan::adaptive_spin{};
+        auto const spin_and_park = [&](std::chrono::nanoseconds const parked_time)
+        {
+            auto wait = asiochan::adaptive_spin::parked_wait{};
+            auto const never_ready = []()
+            {
+                return false;
+            };
+
+            CHECK(not spin.spin(never_ready, wait));
+            std::this_thread::sleep_for(parked_time);
+            wait.woken();
+        };
+
+        while (spin.budget() != asiochan::adaptive_spin::min_budget)
+        {
+            spin_and_park(20ms);
+        }
+
+        for (auto i = 0; i < 32; ++i)
+        {
+            spin_and_park(0ns);
+        }
+        CHECK(spin.budget() >= asiochan::adaptive_spin::default_initial_budget);
+    }
+
+    SECTION("Immediate successes leave the budget unchanged")
+    {
+        static constexpr auto num_values = 64;
+
+        auto channel = asiochan::channel<int, num_values>{};
+        auto spin = asiochan::adaptive_spin{1024};
+
+        for (auto const i : std::views::iota(0, num_values))
+        {
+            REQUIRE(channel.try_write(i));
+        }
+
+        auto read_task = asio::co_spawn(
+            thread_pool,
+            [channel, &spin]() mutable -> asio::awaitable<void>
+            {
+                for (auto const i : std::views::iota(0, num_values))
+                {
+                    auto const recv = co_await channel.read(spin);
+                    CHECK(recv == i);
+                }
+            },
+            asio::use_future);
+
+        read_task.get();
+        CHECK(spin.budget() == 1024);
+    }
+}
+
+#ifdef ASIOCHAN_HAS_CANCELLATION_SLOT
+TEST_CASE("Cancellation")
+{
+    auto io_context = asio::io_context{};
+    auto signal = asio::cancellation_signal{};
+    auto aborted = false;
+
+    auto const check_aborted = [&aborted](asiochan::system::system_error const& error)
+    {
+        aborted = error.code() == asio::error::operation_aborted;
+    };
+
+    SECTION("Cancel pending read")
+    {
+        auto channel = asiochan::channel<int>{};
+
+        asio::co_spawn(
+            io_context,
+            [channel, check_aborted]() mutable -> asio::awaitable<void>
+            {
+                try
+                {
+                    co_await channel.read();
+                }
+                catch (asiochan::system::system_error const& error)
+                {
+                    check_aborted(error);
+                }
+            },
+            asio::bind_cancellation_slot(signal.slot(), asio::detached));
+
+        // Run until the reader is suspended.
+        io_context.poll();
+        signal.emit(asio::cancellation_type::terminal);
+        io_context.run();
+
+        CHECK(aborted);
+        // The reader must no longer be waiting.
+        CHECK(not channel.try_write(0));
+    }
+
+    SECTION("Cancel pending write")
+    {
+        auto channel = asiochan::channel<int>{};
+
+        asio::co_spawn(
+            io_context,
+            [channel, check_aborted]() mutable -> asio::awaitable<void>
+            {
+                try
+                {
+                    co_await channel.write(0);
+                }
+                catch (asiochan::system::system_error const& error)
+                {
+                    check_aborted(error);
+                }
+            },
+            asio::bind_cancellation_slot(signal.slot(), asio::detached));
+
+        io_context.poll();
+        signal.emit(asio::cancellation_type::terminal);
+        io_context.run();
+
+        CHECK(aborted);
+        // The writer must no longer be waiting.
+        CHECK(not channel.try_read().has_value());
+    }
+
+    SECTION("Cancel pending select")
+    {
+        auto ints_1 = asiochan::channel<int>{};
+        auto ints_2 = asiochan::channel<int>{};
+        auto flags = asiochan::channel<bool>{};
+
+        asio::co_spawn(
+            io_context,
+            [ints_1, ints_2, flags, check_aborted]() mutable -> asio::awaitable<void>
+            {
+                try
+                {
+                    co_await asiochan::select(
+                        asiochan::ops::read(ints_1, ints_2),
+                        asiochan::ops::write(true, flags));
+                }
+                catch (asiochan::system::system_error const& error)
+                {
+                    check_aborted(error);
+                }
+            },
+            asio::bind_cancellation_slot(signal.slot(), asio::detached));
+
+        io_context.poll();
+        signal.emit(asio::cancellation_type::terminal);
+        io_context.run();
+
+        CHECK(aborted);
+        // No alternative of the select may still be waiting in any channel.
+        CHECK(not ints_1.try_write(0));
+        CHECK(not ints_2.try_write(0));
+        CHECK(not flags.try_read().has_value());
+    }
+
+    SECTION("Cancellation after completion is ignored")
+    {
+        auto channel = asiochan::channel<int>{};
+        auto received = std::optional<int>{};
+
+        asio::co_spawn(
+            io_context,
+            [channel, &received, check_aborted]() mutable -> asio::awaitable<void>
+            {
+                try
+                {
+                    received = co_await channel.read();
+                }
+                catch (asiochan::system::system_error const& error)
+                {
+                    check_aborted(error);
+                }
+            },
+            asio::bind_cancellation_slot(signal.slot(), asio::detached));
+
+        io_context.poll();
+        // Completes the read, which resumes the reader only once the context runs again.
+        CHECK(channel.try_write(42));
+        signal.emit(asio::cancellation_type::terminal);
+        io_context.run();
+
+        CHECK(not aborted);
+        CHECK(received == std::optional{42});
+    }
+
+    SECTION("Read raced against a timer")
+    {
+        using namespace asio::experimental::awaitable_operators;
+
+        auto channel = asiochan::channel<int>{};
+        auto timed_out = false;
+
+        asio::co_spawn(
+            io_context,
+            [channel, &timed_out]() mutable -> asio::awaitable<void>
+            {
+                auto timer = asio::steady_timer{co_await asio::this_coro::executor, 1ms};
+                auto const result = co_await (channel.read() || timer.async_wait(asio::use_awaitable));
+                timed_out = result.index() == 1;
+            },
+            asio::detached);
+
+        io_context.run();
+
+        CHECK(timed_out);
+        // The losing read must have been cancelled and removed from the channel.
+        CHECK(not channel.try_write(0));
+    }
+}
+#endif
@@ -0,0 +1,179 @@
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <optional>
+
+#include <asiochan/channel.hpp>
+#include <asiochan/frame_pool.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/bind_executor.hpp>
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <asio/io_context.hpp>
+
+#else
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#endif
+
+// AddressSanitizer replaces the global operator new itself, and reports allocations freed by another.
+#if defined(__SANITIZE_ADDRESS__)
+#define ASIOCHAN_TEST_COUNT_ALLOCATIONS 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ASIOCHAN_TEST_COUNT_ALLOCATIONS 0
+#endif
+#endif
+
+#ifndef ASIOCHAN_TEST_COUNT_ALLOCATIONS
+#define ASIOCHAN_TEST_COUNT_ALLOCATIONS 1
+#endif
+
+namespace
+{
+    thread_local auto num_global_allocations = std::size_t{0};
+}  // namespace
+
+#if ASIOCHAN_TEST_COUNT_ALLOCATIONS
+
+// Counts the allocations of the calling thread. This replaces the global allocator,
+// so these tests are built into their own binary, asiochan_frame_pool_tests.
+// Not inlined, so that GCC does not pair their malloc and free with new and delete expressions.
+[[gnu::noinline]] auto operator new(std::size_t const size) -> void*
+{
+    ++num_global_allocations;
+    if (auto const ptr = std::malloc(size != 0 ? size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+namespace asio = asiochan::asio;
+
+TEST_CASE("Frame pool allocations")
+{
+    static constexpr auto num_exchanges = 1000;
+
+    auto io_context = asio::io_context{1};
+    auto channel = asiochan::channel<int, 1>{};
+
+    auto const exchange = [&](int const value)
+    {
+        auto received = std::optional<int>{};
+        channel.async_write(value, asio::bind_executor(io_context, []() {}));
+        channel.async_read(asio::bind_executor(
+            io_context,
+            [&](int const read_value)
+            {
+                received = read_value;
+            }));
+
+        io_context.run();
+        io_context.restart();
+
+        return received == std::optional{value};
+    };
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        REQUIRE(exchange(i));
+    }
+
+    auto const warm_stats = asiochan::this_thread_frame_pool_stats();
+    CHECK(warm_stats.cached >= 1);
+
+    // No assertions in the loop, so that only the channel operations are counted.
+    auto num_received = 0;
+    auto const allocations_before = num_global_allocations;
+    for (auto i = 0; i < num_exchanges; ++i)
+    {
+        num_received += exchange(i) ? 1 : 0;
+    }
+    auto const num_allocations = num_global_allocations - allocations_before;
+
+    CHECK(num_received == num_exchanges);
+
+    // Steady state operations and their posted completions are served from the pool.
+    auto const stats = asiochan::this_thread_frame_pool_stats();
+    CHECK(stats.misses == warm_stats.misses);
+    CHECK(stats.hits > warm_stats.hits);
+    CHECK(stats.cached == warm_stats.cached);
+    if constexpr (ASIOCHAN_TEST_COUNT_ALLOCATIONS)
+    {
+        CHECK(num_allocations == 0);
+    }
+}
+
+TEST_CASE("Awaited operation allocations")
+{
+    static constexpr auto num_warmup_exchanges = 10;
+    static constexpr auto num_exchanges = 1000;
+    static constexpr auto num_total_exchanges = num_warmup_exchanges + num_exchanges;
+
+    auto io_context = asio::io_context{1};
+    auto channel = asiochan::channel<int>{};
+    auto num_received = 0;
+
+    asio::co_spawn(
+        io_context,
+        [&]() -> asio::awaitable<void>
+        {
+            for (auto i = 0; i < num_total_exchanges; ++i)
+            {
+                num_received += (co_await channel.read() == i) ? 1 : 0;
+            }
+        },
+        asio::detached);
+    asio::co_spawn(
+        io_context,
+        [&]() -> asio::awaitable<void>
+        {
+            for (auto i = 0; i < num_total_exchanges; ++i)
+            {
+                co_await channel.write(i);
+            }
+        },
+        asio::detached);
+
+    while (num_received < num_warmup_exchanges)
+    {
+        io_context.run_one();
+    }
+
+    auto const allocations_before = num_global_allocations;
+    while (num_received < num_total_exchanges)
+    {
+        io_context.run_one();
+    }
+    auto const num_allocations = num_global_allocations - allocations_before;
+    io_context.run();
+
+    CHECK(num_received == num_total_exchanges);
+    // Awaited operations are not covered by the frame pool. Each of them allocates
+    // at most the frame ASIO creates to await the completion.
+    if constexpr (ASIOCHAN_TEST_COUNT_ALLOCATIONS)
+    {
+        CHECK(num_allocations <= 2 * num_exchanges);
+    }
+}
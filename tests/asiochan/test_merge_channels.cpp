@@ -0,0 +1,147 @@
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <asiochan/channel.hpp>
+#include <asiochan/merge_channels.hpp>
+#include <asiochan/select.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/detached.hpp>
+#include <asio/io_context.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#endif
+
+namespace asio = asiochan::asio;
+
+TEST_CASE("Merged channels")
+{
+    auto io_context = asio::io_context{1};
+
+    SECTION("Values are read in order across channels")
+    {
+        auto first = asiochan::channel<int, 4>{};
+        auto second = asiochan::unbounded_channel<int>{};
+        auto third = asiochan::channel<int, 4>{};
+        auto merged = asiochan::merge_channels(std::less<>{}, first, second, third);
+
+        for (auto const value : {1, 4, 7, 10})
+        {
+            REQUIRE(first.try_write(value));
+        }
+        for (auto const value : {2, 4, 5, 11})
+        {
+            second.write(value);
+        }
+        for (auto const value : {3, 6, 9, 12})
+        {
+            REQUIRE(third.try_write(value));
+        }
+
+        auto received = std::vector<int>{};
+        while (auto const value = merged.try_read())
+        {
+            received.push_back(*value);
+        }
+
+        // The merge stops once a channel is drained, as its next value may be the least.
+        CHECK(received == std::vector{1, 2, 3, 4, 4, 5, 6, 7, 9, 10});
+        CHECK(not merged.try_read());
+
+        REQUIRE(first.try_write(13));
+        CHECK(merged.try_read() == std::optional{11});
+    }
+
+    SECTION("Reads wait only for channels without a value")
+    {
+        auto first = asiochan::channel<int>{};
+        auto second = asiochan::channel<int, 4>{};
+        auto merged = asiochan::merge_channels(std::greater<>{}, first, second);
+        auto received = std::vector<int>{};
+
+        REQUIRE(second.try_write(8));
+        REQUIRE(second.try_write(2));
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                for (auto i = 0; i < 3; ++i)
+                {
+                    auto const value = co_await merged.read();
+                    received.push_back(value);
+                }
+            },
+            asio::detached);
+
+        io_context.run_one();
+        CHECK(received.empty());
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                co_await first.write(5);
+                co_await first.write(1);
+            },
+            asio::detached);
+
+        io_context.run();
+        CHECK(received == std::vector{8, 5, 2});
+    }
+
+    SECTION("Merged values can be read in a select")
+    {
+        auto first = asiochan::channel<int, 4>{};
+        auto second = asiochan::channel<int, 4>{};
+        auto control = asiochan::channel<bool>{};
+        auto merged = asiochan::merge_channels(std::less<>{}, first, second);
+        auto merged_reader = merged.read_channel(io_context.get_executor());
+        auto received = std::vector<int>{};
+        auto stopped = false;
+
+        for (auto const value : {1, 3, 5})
+        {
+            REQUIRE(first.try_write(value));
+        }
+        for (auto const value : {2, 4, 6})
+        {
+            REQUIRE(second.try_write(value));
+        }
+
+        asio::co_spawn(
+            io_context,
+            [&]() -> asio::awaitable<void>
+            {
+                while (true)
+                {
+                    auto const result = co_await asiochan::select(
+                        merged_reader.read_op(),
+                        asiochan::ops::read(control));
+                    if (result.received_from(control))
+                    {
+                        stopped = true;
+                        co_return;
+                    }
+                    received.push_back(result.get_received<int>());
+                }
+            },
+            asio::detached);
+
+        io_context.poll();
+        CHECK(received == std::vector{1, 2, 3, 4, 5});
+
+        REQUIRE(control.try_write(true));
+        io_context.poll();
+        CHECK(stopped);
+    }
+}
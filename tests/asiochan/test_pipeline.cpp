@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <asiochan/channel.hpp>
+#include <asiochan/pipeline.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/io_context.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+
+#endif
+
+namespace asio = asiochan::asio;
+using namespace std::chrono_literals;
+
+namespace
+{
+    void write_stream(asiochan::unbounded_channel<std::optional<int>>& channel, int const num_values)
+    {
+        for (auto i = 0; i < num_values; ++i)
+        {
+            channel.write(i);
+        }
+        channel.write(std::nullopt);
+    }
+
+    template <typename T>
+    auto read_stream(asiochan::unbounded_channel<std::optional<T>>& channel) -> std::vector<T>
+    {
+        auto values = std::vector<T>{};
+        while (auto value = channel.blocking_read())
+        {
+            values.push_back(std::move(*value));
+        }
+
+        return values;
+    }
+
+    // Fails to write the value 10.
+    struct failing_channel : asiochan::unbounded_channel<std::optional<int>>
+    {
+        auto write(std::optional<int> value) -> asio::awaitable<void>
+        {
+            if (value == 10)
+            {
+                throw std::runtime_error{"write failed"};
+            }
+
+            asiochan::unbounded_channel<std::optional<int>>::write(std::move(value));
+            co_return;
+        }
+    };
+}  // namespace
+
+TEST_CASE("Pipeline stages")
+{
+    static constexpr auto num_values = 200;
+    static constexpr auto parallelism = std::size_t{4};
+
+    auto thread_pool = asio::thread_pool{4};
+    auto input = asiochan::unbounded_channel<std::optional<int>>{};
+    auto output = asiochan::unbounded_channel<std::optional<int>>{};
+
+    // Later values finish first, so parallel workers complete out of order.
+    auto const slow_square = [](int const value)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds{(num_values - value) % 7 * 20});
+        return value * value;
+    };
+
+    auto expected_squares = std::vector<int>{};
+    for (auto i = 0; i < num_values; ++i)
+    {
+        expected_squares.push_back(i * i);
+    }
+
+    SECTION("Transform")
+    {
+        write_stream(input, num_values);
+        auto stage = asio::co_spawn(
+            thread_pool,
+            asiochan::transform(input, output, slow_square, parallelism),
+            asio::use_future);
+
+        auto values = read_stream(output);
+        stage.get();
+        std::ranges::sort(values);
+        CHECK(values == expected_squares);
+    }
+
+    SECTION("Ordered parallel map")
+    {
+        write_stream(input, num_values);
+        auto stage = asio::co_spawn(
+            thread_pool,
+            asiochan::ordered_parallel_map(input, output, slow_square, parallelism),
+            asio::use_future);
+
+        auto const values = read_stream(output);
+        stage.get();
+        CHECK(values == expected_squares);
+    }
+
+    SECTION("Filter")
+    {
+        write_stream(input, num_values);
+        auto stage = asio::co_spawn(
+            thread_pool,
+            asiochan::filter(
+                input,
+                output,
+                [](int const value)
+                {
+                    return value % 3 == 0;
+                }),
+            asio::use_future);
+
+        auto const values = read_stream(output);
+        stage.get();
+        REQUIRE(values.size() == (num_values + 2) / 3);
+        CHECK(std::ranges::all_of(
+            values,
+            [](int const value)
+            {
+                return value % 3 == 0;
+            }));
+        CHECK(std::ranges::is_sorted(values));
+    }
+
+    SECTION("Exceptions stop the stage, end the output and are rethrown")
+    {
+        auto num_calls = std::atomic<int>{0};
+
+        write_stream(input, num_values);
+        auto stage = asio::co_spawn(
+            thread_pool,
+            asiochan::ordered_parallel_map(
+                input,
+                output,
+                [&](int const value)
+                {
+                    ++num_calls;
+                    if (value == 10)
+                    {
+                        throw std::runtime_error{"bad value"};
+                    }
+                    return value;
+                },
+                parallelism),
+            asio::use_future);
+
+        auto const values = read_stream(output);
+        CHECK_THROWS_AS(stage.get(), std::runtime_error);
+        CHECK(std::ranges::find(values, 10) == values.end());
+        CHECK(std::ranges::is_sorted(values));
+
+        // At most the values in the reorder window are processed after the failure,
+        // and the rest of the input is still read.
+        CHECK(num_calls <= 11 + 2 * static_cast<int>(parallelism));
+        CHECK(not input.try_read().has_value());
+    }
+
+    SECTION("Failed writes to the output end the stage")
+    {
+        auto const ordered = GENERATE(false, true);
+
+        auto failing_output = failing_channel{};
+        write_stream(input, num_values);
+        auto const identity = [](int const value)
+        {
+            return value;
+        };
+        auto stage = asio::co_spawn(
+            thread_pool,
+            ordered ? asiochan::ordered_parallel_map(input, failing_output, identity, parallelism)
+                    : asiochan::transform(input, failing_output, identity, parallelism),
+            asio::use_future);
+
+        auto const values = read_stream(failing_output);
+        CHECK_THROWS_AS(stage.get(), std::runtime_error);
+        CHECK(std::ranges::find(values, 10) == values.end());
+        CHECK(values.size() < num_values - 1);
+        CHECK(not input.try_read().has_value());
+    }
+}
+
+TEST_CASE("Batch stage")
+{
+    auto io_context = asio::io_context{1};
+    auto input = asiochan::unbounded_channel<std::optional<int>>{};
+    auto output = asiochan::unbounded_channel<std::optional<std::vector<int>>>{};
+
+    auto stage = asio::co_spawn(io_context, asiochan::batch(input, output, 3, 5ms), asio::use_future);
+
+    SECTION("Full batches")
+    {
+        write_stream(input, 7);
+        io_context.run();
+        stage.get();
+
+        CHECK(read_stream(output) == std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}});
+    }
+
+    SECTION("Partial batches after the delay")
+    {
+        input.write(0);
+        input.write(1);
+
+        auto first = std::optional<std::optional<std::vector<int>>>{};
+        while (not first)
+        {
+            io_context.run_one();
+            first = output.try_read();
+        }
+        CHECK(*first == std::optional{std::vector{0, 1}});
+
+        input.write(std::nullopt);
+        io_context.run();
+        stage.get();
+        CHECK(read_stream(output).empty());
+    }
+}
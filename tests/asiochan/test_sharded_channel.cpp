@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include <asiochan/sharded_channel.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/post.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/this_coro.hpp>
+#include <asio/use_awaitable.hpp>
+#include <asio/use_future.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
+
+#endif
+
+namespace asio = asiochan::asio;
+
+TEST_CASE("Sharded channel")
+{
+    auto const num_threads = GENERATE(range(1u, 4u));
+    auto thread_pool = asio::thread_pool{num_threads};
+
+    SECTION("Many producers, one consumer")
+    {
+        static constexpr auto num_producers = 16;
+        static constexpr auto num_values = 200;
+
+        auto channel = asiochan::sharded_channel<int, 4, 8>{};
+        auto producers = std::vector<std::future<void>>{};
+
+        for (auto producer = 0; producer < num_producers; ++producer)
+        {
+            producers.push_back(asio::co_spawn(
+                thread_pool,
+                [writer = channel.writer(), producer]() mutable -> asio::awaitable<void>
+                {
+                    for (auto const i : std::views::iota(0, num_values))
+                    {
+                        co_await writer.write(producer * num_values + i);
+                    }
+                },
+                asio::use_future));
+        }
+
+        auto const received = asio::co_spawn(
+                                  thread_pool,
+                                  [channel]() mutable -> asio::awaitable<std::vector<int>>
+                                  {
+                                      auto values = std::vector<int>{};
+                                      for (auto i = 0; i < num_producers * num_values; ++i)
+                                      {
+                                          values.push_back(co_await channel.read());
+                                      }
+                                      co_return values;
+                                  },
+                                  asio::use_future)
+                                  .get();
+
+        for (auto& producer : producers)
+        {
+            producer.get();
+        }
+
+        // Every value arrives exactly once, and values of one producer arrive in order.
+        REQUIRE(received.size() == num_producers * num_values);
+        auto last_seen = std::vector<int>(num_producers, -1);
+        for (auto const value : received)
+        {
+            auto const producer = value / num_values;
+            CHECK(value % num_values == last_seen[producer] + 1);
+            last_seen[producer] = value % num_values;
+        }
+    }
+
+    SECTION("Select over all shards")
+    {
+        auto channel = asiochan::sharded_channel<int, 3, 1>{};
+        CHECK(channel.shard(2).try_write(42));
+
+        auto const result = asiochan::select_ready(channel.read_op(), asiochan::ops::nothing);
+        REQUIRE(result.has_value());
+        CHECK(result.get_received<int>() == 42);
+    }
+
+    SECTION("Select does not starve shards under sustained load")
+    {
+        auto channel = asiochan::sharded_channel<int, 2, 1>{};
+        CHECK(channel.shard(1).try_write(1));
+
+        // Shard 0 is refilled before every select, shard 1 must still be read within one round.
+        auto received = std::vector<int>{};
+        for (auto i = 0; i < 2; ++i)
+        {
+            CHECK(channel.shard(0).try_write(0));
+            auto const result = asiochan::select_ready(channel.read_op(), asiochan::ops::nothing);
+            REQUIRE(result.has_value());
+            received.push_back(result.get_received<int>());
+        }
+        CHECK(std::ranges::count(received, 1) == 1);
+
+        auto const selected = asio::co_spawn(
+                                  thread_pool,
+                                  [channel]() mutable -> asio::awaitable<std::vector<int>>
+                                  {
+                                      CHECK(channel.shard(1).try_write(1));
+                                      auto values = std::vector<int>{};
+                                      for (auto i = 0; i < 2; ++i)
+                                      {
+                                          (void)channel.shard(0).try_write(0);
+                                          auto const result = co_await asiochan::select(channel.read_op());
+                                          values.push_back(result.get_received<int>());
+                                      }
+                                      co_return values;
+                                  },
+                                  asio::use_future)
+                                  .get();
+        CHECK(std::ranges::count(selected, 1) == 1);
+    }
+
+    SECTION("Writers keep the order of producers that change threads")
+    {
+        static constexpr auto num_producers = 8;
+        static constexpr auto num_values = 100;
+
+        auto producer_pool = asio::thread_pool{4};
+        auto channel = asiochan::sharded_channel<int, 4, 8>{};
+        auto producers = std::vector<std::future<void>>{};
+
+        for (auto producer = 0; producer < num_producers; ++producer)
+        {
+            producers.push_back(asio::co_spawn(
+                producer_pool,
+                [writer = channel.writer(), producer]() mutable -> asio::awaitable<void>
+                {
+                    for (auto const i : std::views::iota(0, num_values))
+                    {
+                        co_await writer.write(producer * num_values + i);
+
+                        // Resume on any thread of the pool.
+                        co_await asio::post(co_await asio::this_coro::executor, asio::use_awaitable);
+                    }
+                },
+                asio::use_future));
+        }
+
+        auto last_seen = std::vector<int>(num_producers, -1);
+        for (auto i = 0; i < num_producers * num_values; ++i)
+        {
+            auto value = std::optional<int>{};
+            while (not(value = channel.try_read()))
+            {
+                std::this_thread::yield();
+            }
+
+            auto const producer = *value / num_values;
+            CHECK(*value % num_values == last_seen[producer] + 1);
+            last_seen[producer] = *value % num_values;
+        }
+
+        for (auto& producer : producers)
+        {
+            producer.get();
+        }
+    }
+
+    SECTION("Thread affine writes")
+    {
+        auto channel = asiochan::sharded_channel<int, 2, asiochan::unbounded_channel_buff>{};
+        channel.write(1);
+        channel.write(2);
+
+        CHECK(channel.local_shard().try_read() == 1);
+        CHECK(channel.try_read() == 2);
+        CHECK(not channel.try_read().has_value());
+    }
+}
@@ -0,0 +1,133 @@
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+#include <asiochan/asiochan.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+
+#endif
+
+namespace asio = asiochan::asio;
+
+using namespace std::literals;
+
+TEST_CASE("Timer wheel")
+{
+    auto const num_threads = GENERATE(range(1u, 2u));
+    auto thread_pool = asio::thread_pool{num_threads};
+    auto wheel = asiochan::timer_wheel{thread_pool.get_executor()};
+
+    SECTION("Timeout expires")
+    {
+        auto channel = asiochan::channel<int>{};
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = asio::co_spawn(
+                                thread_pool,
+                                [channel, wheel]() mutable -> asio::awaitable<bool>
+                                {
+                                    auto const result = co_await asiochan::select(
+                                        asiochan::ops::read(channel),
+                                        asiochan::ops::timeout(wheel, 10ms));
+
+                                    co_return result.timed_out();
+                                },
+                                asio::use_future)
+                                .get();
+
+        CHECK(result);
+        CHECK(std::chrono::steady_clock::now() - start >= 10ms);
+        CHECK(wheel.num_pending() == 0);
+    }
+
+    SECTION("Successful operation cancels the timeout")
+    {
+        auto channel = asiochan::channel<int>{};
+
+        auto reader = asio::co_spawn(
+            thread_pool,
+            [channel, wheel]() mutable -> asio::awaitable<int>
+            {
+                auto result = co_await asiochan::select(
+                    asiochan::ops::read(channel),
+                    asiochan::ops::timeout(wheel, 1h));
+
+                co_return result.get_received<int>();
+            },
+            asio::use_future);
+
+        auto writer = asio::co_spawn(
+            thread_pool,
+            [channel]() mutable -> asio::awaitable<void>
+            {
+                co_await channel.write(42);
+            },
+            asio::use_future);
+
+        CHECK(reader.get() == 42);
+        writer.get();
+        CHECK(wheel.num_pending() == 0);
+    }
+
+    SECTION("Zero timeout completes immediately")
+    {
+        auto channel = asiochan::channel<void>{};
+
+        auto const result = asio::co_spawn(
+                                thread_pool,
+                                [channel, wheel]() mutable -> asio::awaitable<bool>
+                                {
+                                    auto const result = co_await asiochan::select(
+                                        asiochan::ops::read(channel),
+                                        asiochan::ops::timeout(wheel, 0ms));
+
+                                    co_return result.timed_out();
+                                },
+                                asio::use_future)
+                                .get();
+
+        CHECK(result);
+    }
+
+    SECTION("Many concurrent timeouts")
+    {
+        static constexpr auto num_tasks = 1000;
+
+        auto channel = asiochan::channel<int>{};
+        auto tasks = std::vector<std::future<bool>>{};
+
+        for (auto i = 0; i < num_tasks; ++i)
+        {
+            tasks.push_back(asio::co_spawn(
+                thread_pool,
+                [channel, wheel, i]() mutable -> asio::awaitable<bool>
+                {
+                    auto const result = co_await asiochan::select(
+                        asiochan::ops::read(channel),
+                        asiochan::ops::timeout(wheel, std::chrono::milliseconds{1 + i % 20}));
+
+                    co_return result.timed_out();
+                },
+                asio::use_future));
+        }
+
+        for (auto& task : tasks)
+        {
+            CHECK(task.get());
+        }
+        CHECK(wheel.num_pending() == 0);
+    }
+}
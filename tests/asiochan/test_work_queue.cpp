@@ -0,0 +1,118 @@
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <asiochan/work_queue.hpp>
+#include <catch2/catch.hpp>
+
+#ifdef ASIOCHAN_USE_STANDALONE_ASIO
+
+#include <asio/co_spawn.hpp>
+#include <asio/thread_pool.hpp>
+#include <asio/use_future.hpp>
+
+#else
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+
+#endif
+
+namespace asio = asiochan::asio;
+
+TEST_CASE("Work queue")
+{
+    static constexpr auto num_workers = std::size_t{4};
+    static constexpr auto num_items = 1000;
+    static constexpr auto stop = -1;
+
+    auto const num_threads = GENERATE(range(1u, 4u));
+    auto thread_pool = asio::thread_pool{num_threads};
+    auto queue = asiochan::work_queue<int>{num_workers};
+
+    auto const spawn_workers = [&]()
+    {
+        auto workers = std::vector<std::future<std::pair<long, int>>>{};
+        for (auto worker = std::size_t{0}; worker < num_workers; ++worker)
+        {
+            workers.push_back(asio::co_spawn(
+                thread_pool,
+                [queue, worker]() mutable -> asio::awaitable<std::pair<long, int>>
+                {
+                    auto sum = 0L;
+                    auto count = 0;
+                    while (true)
+                    {
+                        auto const item = co_await queue.pop(worker);
+                        if (item == stop)
+                        {
+                            co_return std::pair{sum, count};
+                        }
+                        sum += item;
+                        ++count;
+                    }
+                },
+                asio::use_future));
+        }
+
+        return workers;
+    };
+
+    auto const stop_workers = [&](auto& workers)
+    {
+        // Workers pop their own queue LIFO, only stop them when all items are taken.
+        while (queue.size() > 0)
+        {
+            std::this_thread::yield();
+        }
+        for (auto i = std::size_t{0}; i < num_workers; ++i)
+        {
+            queue.push(i, stop);
+        }
+
+        auto total = 0L;
+        auto count = 0;
+        for (auto& worker : workers)
+        {
+            auto const [worker_sum, worker_count] = worker.get();
+            total += worker_sum;
+            count += worker_count;
+        }
+
+        CHECK(count == num_items);
+        CHECK(total == static_cast<long>(num_items) * (num_items + 1) / 2);
+        CHECK(queue.size() == 0);
+    };
+
+    SECTION("Items pushed from outside")
+    {
+        auto workers = spawn_workers();
+        for (auto i = 1; i <= num_items; ++i)
+        {
+            queue.push(i);
+        }
+
+        stop_workers(workers);
+    }
+
+    SECTION("Idle workers steal from a busy worker")
+    {
+        for (auto i = 1; i <= num_items; ++i)
+        {
+            queue.push(0, i);
+        }
+        CHECK(queue.size() == num_items);
+
+        // Thieves take the oldest item.
+        auto const stolen = queue.try_pop(1);
+        REQUIRE(stolen.has_value());
+        CHECK(*stolen == 1);
+        queue.push(0, *stolen);
+
+        auto workers = spawn_workers();
+        stop_workers(workers);
+    }
+}